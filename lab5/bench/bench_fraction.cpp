@@ -0,0 +1,155 @@
+// Mixed Fraction arithmetic: + - * / and < over random operand pairs, in operations per second,
+// for each integer width, and sorting random fractions with < and with >. The gcd kernels are timed on their own too: Euclid's modulo-based
+// recursion against the binary (Stein) algorithm that reduce() uses.
+
+#include "bench_common.h"
+#include "fraction.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// @brief A fraction with a numerator in [-max, max] and a denominator in [1, max]
+template<class F>
+F random_fraction(int max) {
+    std::uniform_int_distribution<int> numerator(-max, max), denominator(1, max);
+    int n = numerator(bench_rng());
+    return F(n, denominator(bench_rng()));
+}
+
+// @brief Run n mixed operations (one of + - * / < each) over the operands
+template<class F>
+void bench_mixed(const std::string& name, const std::vector<F>& operands, long long n) {
+    std::size_t count = operands.size();
+    Timer timer;
+    long long less = 0;
+    F acc;
+    for (long long i = 0; i < n; i += 5) {
+        const F& a = operands[i % count];
+        const F& b = operands[(i + 1) % count];
+        consume(a + b);
+        consume(a - b);
+        consume(a * b);
+        if (b != F()) {
+            consume(a / b);
+        }
+        less += a < b;
+    }
+    double ms = timer.elapsed_ms();
+    consume(less);
+    std::cout << name << "\t" << n / ms / 1000 << " Mops/s" << std::endl;
+    bench_report(name, n, ms);
+}
+
+// @brief Euclid's algorithm, as lab5 used it first
+template<class T>
+T gcd_euclid(T a, T b) {
+    return b == 0 ? a : gcd_euclid(b, a % b);
+}
+
+// @brief Binary gcd (Stein's algorithm), in the textbook form
+template<class T>
+T gcd_binary(T a, T b) {
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    do {
+        b >>= __builtin_ctzll(b);
+        if (a > b) {
+            T t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    } while (b != 0);
+    return a << shift;
+}
+
+// @brief Binary gcd where the next shift is computed from the difference, in parallel with min and abs
+template<class T>
+T gcd_binary_diff(T a, T b) {
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    int az = __builtin_ctzll(a), bz = __builtin_ctzll(b), shift = az < bz ? az : bz;
+    b >>= bz;
+    while (a != 0) {
+        a >>= az;
+        int64_t diff = static_cast<int64_t>(b) - static_cast<int64_t>(a);
+        az = __builtin_ctzll(diff);
+        b = a < b ? a : b;
+        a = diff < 0 ? -diff : diff;
+    }
+    return b << shift;
+}
+
+template<class T, class G>
+void bench_gcd(const std::string& name, const std::vector<T>& values, G gcd) {
+    Timer timer;
+    T sum = 0;
+    for (std::size_t i = 0; i + 1 < values.size(); i++) {
+        sum += gcd(values[i], values[i + 1]);
+    }
+    consume(sum);
+    bench_report(name, static_cast<long long>(values.size() - 1), timer.elapsed_ms());
+}
+
+// @brief Sort n random fractions in ascending order (with <) and in descending order (with >)
+template<class F>
+void bench_sort(const std::string& name, long long n, int max) {
+    std::vector<F> values;
+    values.reserve(n);
+    for (long long i = 0; i < n; i++) {
+        values.push_back(random_fraction<F>(max));
+    }
+    std::vector<F> sorted = values;
+    Timer timer;
+    std::sort(sorted.begin(), sorted.end());
+    bench_report(name + " sort <", n, timer.elapsed_ms());
+
+    sorted = values;
+    timer.reset();
+    std::sort(sorted.begin(), sorted.end(), std::greater<F>());
+    bench_report(name + " sort >", n, timer.elapsed_ms());
+    consume(sorted[n / 2]);
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+
+    for (int max : {1000, 1000000}) {
+        std::cout << "Operands up to " << max << std::endl;
+        std::vector<Fraction> f32;
+        std::vector<Fraction64> f64;
+        std::vector<Fraction128> f128;
+        for (int i = 0; i < 4096; i++) {
+            f32.push_back(random_fraction<Fraction>(max));
+        }
+        for (const Fraction& f : f32) {
+            f64.push_back(f);
+            f128.push_back(f);
+        }
+        if (max <= 1000) {
+            bench_mixed("Fraction", f32, n);
+        }
+        bench_mixed("Fraction64", f64, n);
+        bench_mixed("Fraction128", f128, n);
+    }
+
+    std::cout << "Sorting, operands up to 1000000" << std::endl;
+    bench_sort<Fraction>("Fraction", n, 1000000);
+    bench_sort<Fraction64>("Fraction64", n, 1000000);
+    bench_sort<Fraction128>("Fraction128", n, 1000000);
+
+    std::vector<uint64_t> values;
+    std::uniform_int_distribution<uint64_t> dist(1, 1ull << 40);
+    for (long long i = 0; i < n; i++) {
+        values.push_back(dist(bench_rng()));
+    }
+    bench_gcd("gcd Euclid", values, gcd_euclid<uint64_t>);
+    bench_gcd("gcd binary", values, gcd_binary<uint64_t>);
+    bench_gcd("gcd binary diff", values, gcd_binary_diff<uint64_t>);
+    return 0;
+}
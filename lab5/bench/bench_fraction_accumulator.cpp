@@ -0,0 +1,62 @@
+// The sum of 10^7 random fractions with small denominators: added one at a time with
+// operator+, with a FractionAccumulator, and with FractionAccumulator::parallel_sum() on
+// 1, 2 and 4 threads. The denominators are at most 12 (the sum fits in Fraction64) and then
+// at most 30 (it only fits in Fraction128).
+
+#include "bench_common.h"
+#include "fraction_accumulator.h"
+#include <thread>
+#include <vector>
+
+// @brief Time the sum of values with operator+ on F, the accumulator, and the parallel sum
+template<class F>
+void bench_sum(const std::string& name, const std::vector<Fraction>& values) {
+    long long n = values.size();
+    Timer timer;
+    F s1;
+    for (const Fraction& f : values) {
+        s1 = s1 + F(f);
+    }
+    double loop_ms = timer.elapsed_ms();
+    bench_report(name + " operator+", n, loop_ms);
+
+    timer.reset();
+    FractionAccumulator accumulator;
+    for (const Fraction& f : values) {
+        accumulator += f;
+    }
+    Fraction128 s2 = accumulator.sum();
+    double accumulator_ms = timer.elapsed_ms();
+    bench_report(name + " FractionAccumulator", n, accumulator_ms);
+    std::cout << name << "\tspeedup " << loop_ms / accumulator_ms << "x" << std::endl;
+
+    for (unsigned threads : {1u, 2u, 4u}) {
+        timer.reset();
+        Fraction128 s3 = FractionAccumulator::parallel_sum(values, threads);
+        bench_report(name + " parallel_sum, " + std::to_string(threads) + " threads", n, timer.elapsed_ms());
+        if (s3 != s2) {
+            std::cout << "parallel_sum mismatch" << std::endl;
+        }
+    }
+    std::cout << "sum = " << s2 << (Fraction128(s1) == s2 ? "" : " (mismatch)") << std::endl;
+}
+
+// @brief n fractions with numerators in [-1000, 1000] and denominators in [1, max_denominator]
+std::vector<Fraction> random_fractions(long long n, int max_denominator) {
+    std::vector<Fraction> values;
+    std::uniform_int_distribution<int> numerator(-1000, 1000), denominator(1, max_denominator);
+    for (long long i = 0; i < n; i++) {
+        int num = numerator(bench_rng());
+        values.push_back(Fraction(num, denominator(bench_rng())));
+    }
+    return values;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+    std::cout << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    bench_sum<Fraction64>("denominators <= 12", random_fractions(n, 12));
+    bench_sum<Fraction128>("denominators <= 30", random_fractions(n, 30));
+    return 0;
+}
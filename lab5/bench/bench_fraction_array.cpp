@@ -0,0 +1,81 @@
+// Bulk arithmetic on 10^7 pairs of fractions with parts up to 1000: element-wise + - * /, comparison and the sum,
+// done by a loop over std::vector<Fraction> against FractionArray's column-wise operations.
+// Both write their results over an existing array: the loop into a vector of the same size,
+// FractionArray with a compound assignment on a copy of the first operand made beforehand.
+
+#include "bench_common.h"
+#include "fraction_array.h"
+#include <utility>
+#include <vector>
+
+// @brief A fraction with a numerator in [-max, max] and a denominator in [1, max]
+Fraction random_fraction(int max) {
+    std::uniform_int_distribution<int> numerator(-max, max), denominator(1, max);
+    int n = numerator(bench_rng());
+    return Fraction(n, denominator(bench_rng()));
+}
+
+// @brief Time an operation on every pair of elements with a loop over the vectors, then as one
+//        call on the arrays, after resetting the result array c to the first operand a
+template<class Loop, class Bulk>
+void bench_op(const std::string& name, long long n, Loop loop, Bulk bulk, FractionArray& c, const FractionArray& a) {
+    Timer timer;
+    loop();
+    double loop_ms = timer.elapsed_ms();
+    bench_report(name + " vector<Fraction>", n, loop_ms);
+
+    c = a;
+    timer.reset();
+    bulk();
+    double bulk_ms = timer.elapsed_ms();
+    bench_report(name + " FractionArray", n, bulk_ms);
+    std::cout << name << "\tspeedup " << loop_ms / bulk_ms << "x" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+
+    std::vector<Fraction> x, y, z(n);
+    for (long long i = 0; i < n; i++) {
+        x.push_back(random_fraction(1000));
+        // Nonzero, so that every quotient is defined
+        Fraction f = random_fraction(1000);
+        y.push_back(f == Fraction() ? Fraction(1, 1) : f);
+    }
+    FractionArray a(x), b(y), c;
+    std::vector<int> cmp;
+
+    bench_op("add", n, [&]() { for (long long i = 0; i < n; i++) z[i] = x[i] + y[i]; },
+                       [&]() { c += b; }, c, a);
+    bench_op("sub", n, [&]() { for (long long i = 0; i < n; i++) z[i] = x[i] - y[i]; },
+                       [&]() { c -= b; }, c, a);
+    bench_op("mul", n, [&]() { for (long long i = 0; i < n; i++) z[i] = x[i] * y[i]; },
+                       [&]() { c *= b; }, c, a);
+    bench_op("div", n, [&]() { for (long long i = 0; i < n; i++) z[i] = x[i] / y[i]; },
+                       [&]() { c /= b; }, c, a);
+    // Both build a new vector of results
+    bench_op("compare", n, [&]() {
+                               std::vector<int> result(n);
+                               for (long long i = 0; i < n; i++) result[i] = x[i].compare(y[i]);
+                               cmp = std::move(result);
+                           },
+                           [&]() { cmp = a.compare(b); }, c, a);
+    consume(z[n / 2]);
+    consume(c.get(n / 2));
+    consume(cmp[n / 2]);
+
+    // The sum of fractions with small denominators, so that the loop fits in 64 bits
+    std::vector<Fraction> small;
+    std::uniform_int_distribution<int> numerator(-1000, 1000), denominator(1, 12);
+    for (long long i = 0; i < n; i++) {
+        int num = numerator(bench_rng());
+        small.push_back(Fraction(num, denominator(bench_rng())));
+    }
+    FractionArray small_array(small);
+    Fraction64 s1;
+    Fraction128 s2;
+    bench_op("sum", n, [&]() { for (const Fraction& f : small) s1 = s1 + Fraction64(f); },
+                       [&]() { s2 = small_array.sum(); }, c, a);
+    std::cout << "sum = " << s1 << (Fraction128(s1) == s2 ? "" : " (mismatch)") << std::endl;
+    return 0;
+}
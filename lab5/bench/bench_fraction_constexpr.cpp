@@ -0,0 +1,98 @@
+// Rational constants computed at compile time. A table of conversion factors between the SI
+// prefixes from micro to mega, built from std::ratio and reduced while compiling, against the
+// same factors reduced at run time, over 10^7 random conversions of a fraction between two
+// prefixes. The static_asserts fail to compile if the constants are not constant expressions.
+
+#include "bench_common.h"
+#include "fraction.h"
+#include <array>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+#include <vector>
+
+static_assert(Fraction(6, -8) == Fraction(-3, 4));
+static_assert(Fraction(1, 3) + Fraction(1, 6) == Fraction(1, 2));
+static_assert(Fraction(2147483647, 2) + Fraction(1, 2) == Fraction(1073741824, 1));
+static_assert(Fraction64(std::milli()) * Fraction64(std::kilo()) == Fraction64(1, 1));
+static_assert(Fraction128(1, 3) < Fraction128(std::ratio<1000000000000000000, 2999999999999999999>()));
+
+static constexpr Fraction64 third(1, 3);
+static_assert(std::is_same<fraction_ratio<third>, std::ratio<1, 3>>::value);
+
+const std::size_t unit_count = 5;
+constexpr std::array<Fraction64, unit_count> units = {
+    Fraction64(std::micro()), Fraction64(std::milli()), Fraction64(std::ratio<1>()),
+    Fraction64(std::kilo()), Fraction64(std::mega())
+};
+
+typedef std::array<std::array<Fraction64, unit_count>, unit_count> ConversionTable;
+
+// @brief factors[from][to] converts a quantity in the unit from into the unit to
+constexpr ConversionTable conversion_table() {
+    ConversionTable factors = {};
+    for (std::size_t from = 0; from < unit_count; from++) {
+        for (std::size_t to = 0; to < unit_count; to++) {
+            factors[from][to] = units[from] / units[to];
+        }
+    }
+    return factors;
+}
+
+constexpr ConversionTable factors = conversion_table();
+static_assert(factors[0][4] == Fraction64(1, 1000000000000));
+static_assert(factors[3][1] == Fraction64(1000000, 1));
+
+struct Conversion {
+    Fraction64 value;
+    std::size_t from, to;
+};
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+    std::vector<Conversion> conversions;
+    std::uniform_int_distribution<int> part(1, 1000);
+    std::uniform_int_distribution<std::size_t> unit(0, unit_count - 1);
+    for (long long i = 0; i < n; i++) {
+        int num = part(bench_rng());
+        conversions.push_back({Fraction64(num, part(bench_rng())), unit(bench_rng()), unit(bench_rng())});
+    }
+
+    // The parts of the factors as they would be read at run time, e.g. from a configuration
+    std::array<int64_t, unit_count> numerators = {1, 1, 1, 1000, 1000000};
+    std::array<int64_t, unit_count> denominators = {1000000, 1000, 1, 1, 1};
+    consume(numerators);
+    consume(denominators);
+
+    Timer timer;
+    Fraction64 check1;
+    for (const Conversion& c : conversions) {
+        Fraction64 factor = Fraction64(numerators[c.from], denominators[c.from])
+                          / Fraction64(numerators[c.to], denominators[c.to]);
+        Fraction64 result = c.value * factor;
+        consume(result);
+        check1 = result;
+    }
+    bench_report("factors reduced at run time", n, timer.elapsed_ms());
+
+    timer.reset();
+    Fraction64 check2;
+    for (const Conversion& c : conversions) {
+        Fraction64 result = c.value * factors[c.from][c.to];
+        consume(result);
+        check2 = result;
+    }
+    bench_report("constexpr factor table", n, timer.elapsed_ms());
+
+    timer.reset();
+    Fraction64 check3;
+    for (const Conversion& c : conversions) {
+        Fraction64 result = c.value * (units[c.from] / units[c.to]);
+        consume(result);
+        check3 = result;
+    }
+    bench_report("constexpr units, divided at run time", n, timer.elapsed_ms());
+
+    std::cout << (check1 == check2 && check2 == check3 ? "" : "mismatch\n");
+    return 0;
+}
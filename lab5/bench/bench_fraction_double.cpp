@@ -0,0 +1,87 @@
+// Converting 10^7 doubles to fractions. The doubles are decimals with 4 fractional digits in
+// [-1000, 1000], then arbitrary doubles in the same range. Printing each one and parsing the
+// text, as with from_decimal_string before from_double existed, against from_double: exact,
+// with a power of two as the denominator, and as the closest fraction under a maximum
+// denominator. from_doubles converts the whole array at once.
+
+#include "bench_common.h"
+#include "fraction.h"
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+// @brief Time convert(x, f) over values, and return the results. A value that does not fit is
+//        counted and left as zero.
+template<class F, class Convert>
+std::vector<F> bench_convert(const std::string& name, const std::vector<double>& values, Convert convert) {
+    std::vector<F> results(values.size());
+    std::size_t out_of_range = 0;
+    Timer timer;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        try {
+            convert(values[i], results[i]);
+        } catch (const std::out_of_range&) {
+            out_of_range++;
+        }
+    }
+    bench_report(name, values.size(), timer.elapsed_ms());
+    if (out_of_range != 0) {
+        std::cout << name << "\t" << out_of_range << " out of range" << std::endl;
+    }
+    return results;
+}
+
+// @brief Time every conversion of values
+void bench_values(const std::string& title, const std::vector<double>& values) {
+    std::cout << title << std::endl;
+    // 17 significant digits can need a denominator of 10^20 or more
+    bench_convert<Fraction128>("Fraction128 printf %.17g + from_decimal_string", values,
+        [](double x, Fraction128& f) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.17g", x);
+            f.from_decimal_string(buf);
+        });
+    std::vector<Fraction64> shortest = bench_convert<Fraction64>("Fraction64 shortest to_chars + from_chars", values,
+        [](double x, Fraction64& f) {
+            char buf[32];
+            char* end = std::to_chars(buf, buf + sizeof(buf), x).ptr;
+            from_chars(buf, end, f);
+        });
+
+    std::vector<Fraction64> exact = bench_convert<Fraction64>("Fraction64 from_double exact", values,
+        [](double x, Fraction64& f) { f.from_double(x); });
+    std::vector<Fraction64> approximate = bench_convert<Fraction64>("Fraction64 from_double, max 10^4", values,
+        [](double x, Fraction64& f) { f.from_double(x, 10000); });
+    bench_convert<Fraction>("Fraction from_double, max 10^6", values,
+        [](double x, Fraction& f) { f.from_double(x, 1000000); });
+    bench_convert<Fraction64>("Fraction64 from_double, max 10^12", values,
+        [](double x, Fraction64& f) { f.from_double(x, 1000000000000ull); });
+
+    std::vector<Fraction64> batch(values.size());
+    Timer timer;
+    from_doubles(values.data(), values.data() + values.size(), batch.data(), 10000);
+    bench_report("Fraction64 from_doubles, max 10^4", values.size(), timer.elapsed_ms());
+
+    std::size_t same = 0, exact_same = 0;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        same += approximate[i] == shortest[i];
+        exact_same += exact[i].to_double() == values[i] && (values[i] == 0 || exact[i] != Fraction64());
+    }
+    std::cout << "max 10^4 equal to the shortest decimal: " << same << ", exact round trips: " << exact_same
+              << (batch == approximate ? "" : ", from_doubles mismatch") << std::endl;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+    std::vector<double> decimals, doubles;
+    std::uniform_int_distribution<int> ten_thousandths(-10000000, 10000000);
+    std::uniform_real_distribution<double> uniform(-1000, 1000);
+    for (long long i = 0; i < n; i++) {
+        decimals.push_back(ten_thousandths(bench_rng()) / 10000.0);
+        doubles.push_back(uniform(bench_rng()));
+    }
+    bench_values("Decimals with 4 fractional digits", decimals);
+    bench_values("Arbitrary doubles", doubles);
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Reading and writing 10^7 fractions from and to a text file, one per line: half of them
+// "a/b", a quarter integers and a quarter decimals, half of those with an exponent.
+// Parsing with the stream operator >> against from_chars over the whole file read into memory,
+// and printing with << against to_chars into a buffer that is written out when it is full.
+// The file is written to the path given as the second argument (bench_fraction_io.txt by
+// default) and removed at the end.
+
+#include "bench_common.h"
+#include "fraction.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// @brief A random line of the input file
+std::string random_line() {
+    std::uniform_int_distribution<int> kind(0, 7), part(-1000000, 1000000), denominator(1, 1000000),
+                                       fraction_digits(0, 9999), exponent(-4, 4);
+    int k = kind(bench_rng());
+    std::string line = std::to_string(part(bench_rng()));
+    if (k < 4) {
+        line += "/" + std::to_string(denominator(bench_rng()));
+    } else if (k >= 6) {
+        // A decimal with 4 fractional digits, keeping its leading zeros
+        std::string digits = std::to_string(fraction_digits(bench_rng()));
+        line = line.substr(0, line.size() - line.size() / 2) + "." + std::string(4 - digits.size(), '0') + digits;
+        if (k == 7) {
+            line += "e" + std::to_string(exponent(bench_rng()));
+        }
+    }
+    return line;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+    std::string path = argc > 2 ? argv[2] : "bench_fraction_io.txt";
+    {
+        std::ofstream out(path);
+        for (long long i = 0; i < n; i++) {
+            out << random_line() << '\n';
+        }
+    }
+
+    Timer timer;
+    std::vector<Fraction> values(n);
+    {
+        std::ifstream in(path);
+        for (Fraction& f : values) {
+            in >> f;
+        }
+    }
+    bench_report("parse operator>>", n, timer.elapsed_ms());
+
+    std::vector<Fraction> parsed(n);
+    timer.reset();
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        std::string text(in.tellg(), '\0');
+        in.seekg(0);
+        in.read(&text[0], text.size());
+        const char *p = text.data(), *end = text.data() + text.size();
+        for (Fraction& f : parsed) {
+            while (p != end && (*p == '\n' || *p == ' ')) {
+                p++;
+            }
+            p = from_chars(p, end, f).ptr;
+        }
+    }
+    bench_report("parse from_chars", n, timer.elapsed_ms());
+    std::cout << (parsed == values ? "" : "parse mismatch\n");
+
+    timer.reset();
+    {
+        std::ofstream out(path);
+        for (const Fraction& f : values) {
+            out << f << '\n';
+        }
+    }
+    bench_report("print operator<<", n, timer.elapsed_ms());
+
+    timer.reset();
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::vector<char> buffer(1 << 16);
+        char *p = buffer.data(), *end = buffer.data() + buffer.size();
+        for (const Fraction& f : values) {
+            if (end - p < static_cast<long>(Fraction::max_chars + 1)) {
+                out.write(buffer.data(), p - buffer.data());
+                p = buffer.data();
+            }
+            p = to_chars(p, end, f).ptr;
+            *p++ = '\n';
+        }
+        out.write(buffer.data(), p - buffer.data());
+    }
+    bench_report("print to_chars", n, timer.elapsed_ms());
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Fraction in bulk: the memory an array of fractions takes, and the throughput of simple passes
+// over it (copying, comparing, multiplying neighbours, converting to double and hashing),
+// which depend on how many fractions fit in a cache line.
+
+#include "bench_common.h"
+#include "fraction.h"
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 100000000);
+
+    std::cout << "sizeof(Fraction) = " << sizeof(Fraction) << ", " << n << " fractions take "
+              << sizeof(Fraction) * n / 1000000 << " MB" << std::endl;
+
+    Timer timer;
+    std::vector<Fraction> values;
+    values.reserve(n);
+    for (long long i = 0; i < n; i++) {
+        values.push_back(Fraction(static_cast<int>(i % 2001) - 1000, static_cast<int>(i % 997) + 1));
+    }
+    bench_report("construct", n, timer.elapsed_ms());
+
+    timer.reset();
+    std::vector<Fraction> copy = values;
+    bench_report("copy", n, timer.elapsed_ms());
+    consume(copy[n / 2]);
+    copy = std::vector<Fraction>();
+
+    timer.reset();
+    Fraction half(1, 2);
+    long long less = 0;
+    for (const Fraction& f : values) {
+        less += f < half;
+    }
+    bench_report("compare", n, timer.elapsed_ms());
+    consume(less);
+
+    timer.reset();
+    for (long long i = 0; i + 1 < n; i++) {
+        values[i] = values[i] * values[i + 1];
+    }
+    bench_report("multiply", n - 1, timer.elapsed_ms());
+
+    timer.reset();
+    double sum = 0;
+    for (const Fraction& f : values) {
+        sum += f.to_double();
+    }
+    bench_report("to_double", n, timer.elapsed_ms());
+    consume(sum);
+
+    timer.reset();
+    std::size_t hash_sum = 0;
+    for (const Fraction& f : values) {
+        hash_sum += std::hash<Fraction>()(f);
+    }
+    bench_report("hash", n, timer.elapsed_ms());
+    consume(hash_sum);
+
+    // The distinct values among the first fractions, as hash set keys
+    long long keys = n < 10000000 ? n : 10000000;
+    timer.reset();
+    std::unordered_set<Fraction> distinct(values.begin(), values.begin() + keys);
+    bench_report("unordered_set insert", keys, timer.elapsed_ms());
+    std::cout << distinct.size() << " distinct fractions" << std::endl;
+    return 0;
+}
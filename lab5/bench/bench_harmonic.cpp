@@ -0,0 +1,95 @@
+// Exact harmonic sums H(n) = 1 + 1/2 + ... + 1/n.
+// The fixed-width fractions overflow within a few dozen terms; BigFraction carries on to n = 10^5,
+// where the denominator has about 43000 digits. The building blocks of BigInteger are timed too:
+// schoolbook against Karatsuba multiplication, and Lehmer's gcd against Euclid's.
+
+#include "bench_common.h"
+#include "big_fraction.h"
+#include "fraction.h"
+#include <string>
+
+// @brief Return the first n for which H(n) overflows the fraction type F
+template<class F>
+long long first_overflow() {
+    F sum;
+    for (long long n = 1;; n++) {
+        try {
+            sum = sum + F(1, n);
+        } catch (const char*) {
+            return n;
+        }
+    }
+}
+
+// @brief A random number with the given number of limbs
+BigInteger random_big(int limbs) {
+    std::string digits;
+    std::uniform_int_distribution<int> digit(0, 9);
+    for (int i = 0; i < limbs * 19 + 1; i++) {
+        digits += static_cast<char>('0' + (i == 0 ? 1 + digit(bench_rng()) % 9 : digit(bench_rng())));
+    }
+    BigInteger x;
+    x.from_string(digits);
+    return x;
+}
+
+// @brief Euclid's algorithm with full divisions, as the reference for Lehmer's
+BigInteger gcd_euclid(BigInteger a, BigInteger b) {
+    while (!b.is_zero()) {
+        BigInteger r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+int main(int argc, char **argv) {
+    long long max_n = bench_size(argc, argv, 100000);
+
+    std::cout << "H(n) first overflows at n =" << std::endl;
+    std::cout << "Fraction\t" << first_overflow<Fraction>() << std::endl;
+    std::cout << "Fraction64\t" << first_overflow<Fraction64>() << std::endl;
+    std::cout << "Fraction128\t" << first_overflow<Fraction128>() << std::endl;
+
+    std::cout << "BigFraction H(n): n, time, digits of the denominator, value" << std::endl;
+    for (long long n = 10; n <= max_n; n *= 10) {
+        Timer timer;
+        BigFraction sum;
+        for (long long k = 1; k <= n; k++) {
+            sum = sum + BigFraction(1, k);
+        }
+        double ms = timer.elapsed_ms();
+        std::cout << "H(" << n << ")\t" << ms << " ms\t" << sum.get_denominator().to_string().size() << " digits\t" << sum.to_double() << std::endl;
+    }
+
+    std::cout << "Multiplication of two n-limb numbers: schoolbook, Karatsuba (threshold " << BigInteger::karatsuba_threshold << ")" << std::endl;
+    int default_threshold = BigInteger::karatsuba_threshold;
+    for (int limbs = 16; limbs <= 4096; limbs *= 2) {
+        BigInteger a = random_big(limbs), b = random_big(limbs);
+        int rounds = std::max(1, 4000000 / (limbs * limbs));
+        double ms[2];
+        for (int karatsuba = 0; karatsuba < 2; karatsuba++) {
+            BigInteger::karatsuba_threshold = karatsuba ? default_threshold : 1 << 30;
+            Timer timer;
+            for (int r = 0; r < rounds; r++) {
+                consume(a * b);
+            }
+            ms[karatsuba] = timer.elapsed_ms() / rounds;
+        }
+        std::cout << limbs << " limbs\t" << ms[0] * 1000 << " us\t" << ms[1] * 1000 << " us" << std::endl;
+    }
+    BigInteger::karatsuba_threshold = default_threshold;
+
+    std::cout << "gcd of two n-limb numbers: Euclid, Lehmer" << std::endl;
+    for (int limbs = 4; limbs <= 1024; limbs *= 4) {
+        BigInteger a = random_big(limbs), b = random_big(limbs);
+        Timer timer;
+        BigInteger g1 = gcd_euclid(a, b);
+        double euclid_ms = timer.elapsed_ms();
+        timer.reset();
+        BigInteger g2 = BigInteger::gcd(a, b);
+        double lehmer_ms = timer.elapsed_ms();
+        std::cout << limbs << " limbs\t" << euclid_ms << " ms\t" << lehmer_ms << " ms" << (g1 == g2 ? "" : "\tMISMATCH") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Solving a random n x n linear system A x = b exactly (n = 200 by default), with entries
+// a/b, |a| <= 9 and 1 <= b <= 9. Naive Gaussian elimination with fraction operations on
+// Fraction and Fraction128, which overflow within a few columns, and on BigFraction, which
+// reduces a gcd at every operation; against RationalMatrix, which eliminates the integer rows
+// with Bareiss' fraction-free algorithm, on one thread and on every hardware thread. The
+// determinant, rank and inverse of RationalMatrix are timed too.
+
+#include "bench_common.h"
+#include "rational_matrix.h"
+#include <thread>
+#include <vector>
+
+// @brief Solve a x = b by Gaussian elimination and back substitution on the fractions
+//        themselves. Return the column at which an operation overflowed in column, or
+//        a.size() if it did not.
+template<class F>
+std::vector<F> naive_solve(std::vector<std::vector<F>> a, std::vector<F> b, std::size_t& column) {
+    std::size_t n = a.size();
+    F zero;
+    try {
+        for (column = 0; column < n; column++) {
+            std::size_t p = column;
+            while (a[p][column] == zero) {
+                p++;
+            }
+            std::swap(a[p], a[column]);
+            std::swap(b[p], b[column]);
+            for (std::size_t i = column + 1; i < n; i++) {
+                F factor = a[i][column] / a[column][column];
+                for (std::size_t j = column + 1; j < n; j++) {
+                    a[i][j] = a[i][j] - factor * a[column][j];
+                }
+                a[i][column] = zero;
+                b[i] = b[i] - factor * b[column];
+            }
+        }
+        std::vector<F> x(n);
+        for (std::size_t i = n; i-- > 0;) {
+            F sum = b[i];
+            for (std::size_t j = i + 1; j < n; j++) {
+                sum = sum - a[i][j] * x[j];
+            }
+            x[i] = sum / a[i][i];
+        }
+        return x;
+    } catch (const char*) {
+        return std::vector<F>();
+    }
+}
+
+// @brief Time naive_solve on F and report how far it got
+template<class F, class Convert>
+std::vector<F> bench_naive(const std::string& name, const std::vector<std::vector<Fraction>>& a,
+                           const std::vector<Fraction>& b, Convert convert) {
+    std::vector<std::vector<F>> fa;
+    std::vector<F> fb;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        fa.emplace_back();
+        for (const Fraction& f : a[i]) {
+            fa.back().push_back(convert(f));
+        }
+        fb.push_back(convert(b[i]));
+    }
+    Timer timer;
+    std::size_t column = 0;
+    std::vector<F> x = naive_solve(fa, fb, column);
+    double ms = timer.elapsed_ms();
+    if (x.empty()) {
+        std::cout << name << "\toverflows at column " << column << " of " << a.size() << std::endl;
+    } else {
+        bench_report(name, a.size(), ms);
+    }
+    return x;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 200);
+    std::uniform_int_distribution<int> numerator(-9, 9), denominator(1, 9);
+    std::vector<std::vector<Fraction>> a(n, std::vector<Fraction>(n));
+    std::vector<std::vector<Fraction>> b(n, std::vector<Fraction>(1));
+    std::vector<Fraction> column(n);
+    for (long long i = 0; i < n; i++) {
+        for (Fraction& f : a[i]) {
+            int num = numerator(bench_rng());
+            f = Fraction(num, denominator(bench_rng()));
+        }
+        int num = numerator(bench_rng());
+        column[i] = b[i][0] = Fraction(num, denominator(bench_rng()));
+    }
+    std::cout << n << " x " << n << ", " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    bench_naive<Fraction>("naive Fraction solve", a, column, [](const Fraction& f) { return f; });
+    bench_naive<Fraction128>("naive Fraction128 solve", a, column, [](const Fraction& f) { return Fraction128(f); });
+    std::vector<BigFraction> naive = bench_naive<BigFraction>("naive BigFraction solve", a, column,
+        [](const Fraction& f) { return BigFraction(f.get_numerator(), f.get_denominator()); });
+
+    RationalMatrix matrix(a), rhs(b);
+    std::vector<unsigned> thread_counts = {1};
+    if (std::thread::hardware_concurrency() > 1) {
+        thread_counts.push_back(std::thread::hardware_concurrency());
+    }
+    for (unsigned threads : thread_counts) {
+        RationalMatrix::threads = threads;
+        std::string suffix = ", " + std::to_string(threads) + " threads";
+        Timer timer;
+        RationalMatrix x = matrix.solve(rhs);
+        bench_report("Bareiss solve" + suffix, n, timer.elapsed_ms());
+        for (long long i = 0; i < n; i++) {
+            if (x.get(i, 0) != naive[i]) {
+                std::cout << "solve mismatch" << std::endl;
+                break;
+            }
+        }
+
+        timer.reset();
+        BigFraction det = matrix.determinant();
+        bench_report("Bareiss determinant" + suffix, n, timer.elapsed_ms());
+        timer.reset();
+        std::size_t rank = matrix.rank();
+        bench_report("Bareiss rank" + suffix, n, timer.elapsed_ms());
+        timer.reset();
+        RationalMatrix inverse = matrix.inverse();
+        bench_report("Bareiss inverse" + suffix, n, timer.elapsed_ms());
+        std::cout << "rank " << rank << ", determinant has " << det.get_numerator().bit_length() << " / "
+                  << det.get_denominator().bit_length() << " bits" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef __BIG_FRACTION_H__
+#define __BIG_FRACTION_H__
+
+#include <iostream>
+#include <string>
+#include "big_integer.h"
+
+// Fraction of arbitrary-precision integers, with the same interface as Fraction.
+// It is always in lowest terms, with the sign on the numerator and a positive denominator.
+class BigFraction {
+private:
+    BigInteger numerator;
+    BigInteger denominator;
+
+    // @brief Reduce the fraction to lowest terms
+    void reduce();
+
+    // friend functions for input/output stream
+    friend std::istream& operator>>(std::istream& is, BigFraction& f);
+    friend std::ostream& operator<<(std::ostream& os, const BigFraction& f);
+
+public:
+    BigFraction();
+    BigFraction(const BigInteger& numerator, const BigInteger& denominator);
+    BigFraction(long long numerator, long long denominator);
+
+    // overload arthematical operators
+    BigFraction operator+(const BigFraction& other) const;
+    BigFraction operator-(const BigFraction& other) const;
+    BigFraction operator*(const BigFraction& other) const;
+    BigFraction operator/(const BigFraction& other) const;
+
+    // overload comparison operators
+    bool operator==(const BigFraction& other) const;
+    bool operator!=(const BigFraction& other) const;
+    bool operator<(const BigFraction& other) const;
+    bool operator<=(const BigFraction& other) const;
+    bool operator>(const BigFraction& other) const;
+    bool operator>=(const BigFraction& other) const;
+
+    const BigInteger& get_numerator() const;
+    const BigInteger& get_denominator() const;
+
+    // convert BigFraction to other types
+    double to_double() const;
+    std::string to_string() const;
+
+    // convert BigFraction from other types
+    void from_string(const std::string& str);
+    void from_decimal_string(const std::string& str);
+};
+
+#endif
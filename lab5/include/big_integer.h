@@ -0,0 +1,75 @@
+#ifndef __BIG_INTEGER_H__
+#define __BIG_INTEGER_H__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision signed integer.
+// The magnitude is a vector of 64-bit limbs, least significant first, with no leading zero limbs,
+// so zero has no limbs (and is never negative).
+class BigInteger {
+private:
+    std::vector<uint64_t> limbs;
+    bool negative;
+
+    BigInteger(std::vector<uint64_t> limbs, bool negative);
+
+    // friend functions for input/output stream
+    friend std::istream& operator>>(std::istream& is, BigInteger& x);
+    friend std::ostream& operator<<(std::ostream& os, const BigInteger& x);
+
+public:
+    // Operands of at least this many limbs are multiplied with Karatsuba's algorithm,
+    // smaller ones with the schoolbook algorithm
+    static int karatsuba_threshold;
+
+    BigInteger();
+    BigInteger(long long value);
+
+    // overload arthematical operators, / and % truncate toward zero like the built-in ones
+    BigInteger operator-() const;
+    BigInteger operator+(const BigInteger& other) const;
+    BigInteger operator-(const BigInteger& other) const;
+    BigInteger operator*(const BigInteger& other) const;
+    BigInteger operator/(const BigInteger& other) const;
+    BigInteger operator%(const BigInteger& other) const;
+    BigInteger operator<<(int bits) const;
+    BigInteger operator>>(int bits) const;
+
+    // overload comparison operators
+    bool operator==(const BigInteger& other) const;
+    bool operator!=(const BigInteger& other) const;
+    bool operator<(const BigInteger& other) const;
+    bool operator<=(const BigInteger& other) const;
+    bool operator>(const BigInteger& other) const;
+    bool operator>=(const BigInteger& other) const;
+
+    // @brief Return a negative number, zero or a positive number as this is less than, equal to or greater than other
+    int compare(const BigInteger& other) const;
+
+    // @brief Return -1, 0 or 1
+    int sign() const;
+    bool is_zero() const;
+    BigInteger abs() const;
+
+    // @brief Return the number of limbs and the number of significant bits of the magnitude
+    int size() const;
+    long long bit_length() const;
+
+    // @brief Compute the quotient and the remainder at once
+    static void divmod(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder);
+
+    // @brief Compute the greatest common divisor (non-negative) with Lehmer's algorithm
+    static BigInteger gcd(const BigInteger& a, const BigInteger& b);
+
+    // convert BigInteger to other types
+    double to_double() const;
+    std::string to_string() const;
+
+    // convert BigInteger from a decimal string
+    void from_string(const std::string& str);
+};
+
+#endif
@@ -1,49 +1,576 @@
 #ifndef __FRACTION_H__
 #define __FRACTION_H__
 
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <ratio>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#if __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
+#endif
+
+// Integer types a BasicFraction can be built on, the type each one is promoted to when an
+// intermediate result overflows, and helpers shared by the fraction classes
+namespace fraction_detail {
+
+template<class Int>
+struct int_traits {
+    static_assert(sizeof(Int) == 4 || sizeof(Int) == 8 || sizeof(Int) == 16,
+                  "BasicFraction supports 32-, 64- and 128-bit integers");
+
+    typedef std::conditional_t<sizeof(Int) == 4, uint32_t,
+            std::conditional_t<sizeof(Int) == 8, uint64_t, unsigned __int128>> unsigned_type;
+    typedef std::conditional_t<sizeof(Int) == 4, int32_t,
+            std::conditional_t<sizeof(Int) == 8, int64_t, __int128>> signed_type;
+
+    // The next wider signed type, or void for the widest one
+    typedef std::conditional_t<sizeof(Int) == 4, int64_t,
+            std::conditional_t<sizeof(Int) == 8, __int128, void>> wider_type;
+
+    static constexpr Int max = static_cast<Int>(static_cast<unsigned_type>(-1) >> 1);
+    // The number of decimal digits of max
+    static constexpr int max_digits = sizeof(Int) == 4 ? 10 : sizeof(Int) == 8 ? 19 : 39;
+};
+
+// @brief Compute sgn(x)
+template<class T>
+constexpr int sgn(T x) {
+    if (x > 0) {
+        return 1;
+    } else if (x < 0) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+// @brief Compute |x| as an unsigned number, so that |INT_MIN| does not overflow
+template<class T, class U = typename int_traits<T>::unsigned_type>
+constexpr U magnitude(T x) {
+    return x >= 0 ? static_cast<U>(x) : static_cast<U>(0) - static_cast<U>(x);
+}
 
-class Fraction {
+// @brief Count the trailing zero bits of x, which is not zero
+template<class T>
+constexpr int ctz(T x) {
+    if constexpr (sizeof(T) <= 4) {
+        return __builtin_ctz(static_cast<uint32_t>(x));
+    } else if constexpr (sizeof(T) <= 8) {
+        return __builtin_ctzll(static_cast<uint64_t>(x));
+    } else {
+        uint64_t low = static_cast<uint64_t>(x);
+        return low != 0 ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<uint64_t>(static_cast<unsigned __int128>(x) >> 64));
+    }
+}
+
+// @brief Compute the greatest common divisor of a and b (both non-negative and at most the
+//        max of the signed type of the same width) using the binary
+//        (Stein) algorithm: shifts and subtractions instead of divisions.
+//        The shift of the next step is taken from the difference, so that it does not wait for
+//        min and abs, which keeps the loop-carried dependency chain short. The loop stops when
+//        the difference is zero, before its trailing zeros would be counted.
+template<class T>
+constexpr T gcd(T a, T b) {
+    typedef typename fraction_detail::int_traits<T>::signed_type S;
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    int az = ctz(a), bz = ctz(b), shift = az < bz ? az : bz;
+    b >>= bz;
+    while (true) {
+        a >>= az;
+        // a and b are at most the max of S, so the difference fits in S
+        S diff = static_cast<S>(b) - static_cast<S>(a);
+        b = a < b ? a : b;
+        if (diff == 0) {
+            break;
+        }
+        az = ctz(diff);
+        a = static_cast<T>(diff < 0 ? -diff : diff);
+    }
+    return b << shift;
+}
+
+// @brief Multiply x and y into the 256-bit product high * 2^128 + low
+constexpr void multiply_wide(unsigned __int128 x, unsigned __int128 y, unsigned __int128& high, unsigned __int128& low) {
+    typedef unsigned __int128 u128;
+    u128 x0 = static_cast<uint64_t>(x), x1 = x >> 64;
+    u128 y0 = static_cast<uint64_t>(y), y1 = y >> 64;
+    u128 p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    // The sum of three values below 2^64 cannot overflow
+    u128 middle = (p00 >> 64) + static_cast<uint64_t>(p01) + static_cast<uint64_t>(p10);
+    low = (middle << 64) | static_cast<uint64_t>(p00);
+    high = p11 + (p01 >> 64) + (p10 >> 64) + (middle >> 64);
+}
+
+// @brief Compare a * b with c * d, all non-negative, by their full 256-bit products
+// @return -1, 0 or 1
+constexpr int compare_products(unsigned __int128 a, unsigned __int128 b, unsigned __int128 c, unsigned __int128 d) {
+    unsigned __int128 high1 = 0, low1 = 0, high2 = 0, low2 = 0;
+    multiply_wide(a, b, high1, low1);
+    multiply_wide(c, d, high2, low2);
+    if (high1 != high2) {
+        return high1 < high2 ? -1 : 1;
+    }
+    return (low1 > low2) - (low1 < low2);
+}
+
+// @brief The 64-bit finalizer of MurmurHash3, which spreads every input bit over the whole result
+inline uint64_t hash_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// @brief Hash the two parts of a fraction. The parts of a 32-bit fraction are packed into a
+//        single 64-bit word; wider parts are mixed in 64 bits at a time.
+template<class UInt>
+inline std::size_t hash_parts(UInt numerator, UInt denominator) {
+    if constexpr (sizeof(UInt) == 4) {
+        return hash_mix(static_cast<uint64_t>(numerator) << 32 | denominator);
+    } else {
+        uint64_t h = hash_mix(static_cast<uint64_t>(numerator));
+        if constexpr (sizeof(UInt) == 16) {
+            h = hash_mix(h ^ static_cast<uint64_t>(numerator >> 64));
+            h = hash_mix(h ^ static_cast<uint64_t>(denominator >> 64));
+        }
+        return hash_mix(h ^ static_cast<uint64_t>(denominator));
+    }
+}
+
+}   // namespace fraction_detail
+
+// Fraction on the integer type Int (int32_t, int64_t or __int128).
+// It is stored in canonical form: a signed numerator carrying the sign of the fraction and a
+// positive unsigned denominator, coprime, with zero as 0/1, so equal fractions have equal bits
+// and a Fraction takes 8 bytes. Both parts stay within [-max, max] of Int, so negating the
+// numerator or swapping the parts (in a division) never overflows.
+// Every intermediate product and sum is checked with __builtin_mul_overflow and
+// __builtin_add_overflow. Multiplication and division cross-reduce first, so their products
+// are already in lowest terms. If an intermediate of another operation overflows, the
+// operation is redone in the next wider type and the reduced result is narrowed back;
+// only a result that does not fit in Int after reduction is reported as an overflow.
+// The constructors, arithmetic and comparisons are constexpr and defined in this header, so
+// rational constants are computed at compile time and the operations are inlined; an error
+// throws, which in a constant expression is a compile error. Parsing and formatting are
+// defined in fraction.cpp.
+class FractionArray;
+class FractionAccumulator;
+
+template<class Int>
+class BasicFraction {
 private:
-    int numerator;
-    int denominator;
-    int sign;   // the sign of the fraction, 1 for positive, -1 for negative, 0 for zero
+    typedef fraction_detail::int_traits<Int> traits;
+    typedef typename traits::unsigned_type UInt;
+    typedef typename traits::wider_type Wide;
+
+    Int numerator;      // carries the sign of the fraction
+    UInt denominator;   // always positive
 
-    // @brief Reduce the fraction to lowest terms
-    void reduce();
+    // @brief Reduce numerator/denominator to canonical form, if it fits in Int
+    static constexpr BasicFraction<Int> reduce(Int numerator, Int denominator);
 
-    // friend functions for input/output stream
-    friend std::istream& operator>>(std::istream& is, Fraction& f);
-    friend std::ostream& operator<<(std::ostream& os, const Fraction& f);
+    // @brief Build a fraction from a wider result, if it fits in Int after reduction
+    template<class W> static constexpr BasicFraction<Int> narrow(W numerator, W denominator);
+
+    // @brief Build a fraction from reduced magnitudes, if they fit in Int
+    static constexpr BasicFraction<Int> from_reduced(UInt numerator, UInt denominator, bool negative);
+
+    // @brief Build the fraction of a std::ratio, which is already reduced
+    template<class R> static constexpr BasicFraction<Int> from_ratio();
+
+    template<class> friend class BasicFraction;
+    // from_chars builds the fraction it parses from parts it has already reduced
+    template<class I> friend std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<I>& value);
+    // FractionArray builds its elements from parts that are already canonical, and
+    // FractionAccumulator reads the parts without a call per fraction
+    friend class FractionArray;
+    friend class FractionAccumulator;
 
 public:
-    Fraction();
-    Fraction(int numerator, int denominator);
-    Fraction(int numerator, int denominator, int sign);
-    Fraction(const Fraction& other);
+    typedef Int int_type;
+
+    // The length of the longest output of to_chars: a sign, two parts and a slash
+    static constexpr std::size_t max_chars = 2 * traits::max_digits + 2;
+
+    constexpr BasicFraction();
+    constexpr BasicFraction(Int numerator, Int denominator);
+    constexpr BasicFraction(Int numerator, Int denominator, int sign);
+    // Copies are already in lowest terms, so they are not reduced again
+    constexpr BasicFraction(const BasicFraction<Int>& other) = default;
+
+    // Widen a fraction of a narrower integer type
+    template<class Narrow, class = std::enable_if_t<(sizeof(Narrow) < sizeof(Int))>>
+    constexpr BasicFraction(const BasicFraction<Narrow>& other);
+
+    // The value of a std::ratio, e.g. Fraction(std::milli()) is 1/1000
+    template<std::intmax_t N, std::intmax_t D>
+    constexpr BasicFraction(std::ratio<N, D>);
+
+    constexpr BasicFraction<Int>& operator=(const BasicFraction<Int>& other) = default;
 
     // overload arthematical operators
-    Fraction operator+(const Fraction& other) const;
-    Fraction operator-(const Fraction& other) const;
-    Fraction operator*(const Fraction& other) const;
-    Fraction operator/(const Fraction& other) const;
+    constexpr BasicFraction<Int> operator+(const BasicFraction<Int>& other) const;
+    constexpr BasicFraction<Int> operator-(const BasicFraction<Int>& other) const;
+    constexpr BasicFraction<Int> operator*(const BasicFraction<Int>& other) const;
+    constexpr BasicFraction<Int> operator/(const BasicFraction<Int>& other) const;
 
     // overload comparison operators
-    bool operator==(const Fraction& other) const;
-    bool operator!=(const Fraction& other) const;
-    bool operator<(const Fraction& other) const;
-    bool operator<=(const Fraction& other) const;
-    bool operator>(const Fraction& other) const;
-    bool operator>=(const Fraction& other) const;
+    constexpr bool operator==(const BasicFraction<Int>& other) const;
+    constexpr bool operator!=(const BasicFraction<Int>& other) const;
+    constexpr bool operator<(const BasicFraction<Int>& other) const;
+    constexpr bool operator<=(const BasicFraction<Int>& other) const;
+    constexpr bool operator>(const BasicFraction<Int>& other) const;
+    constexpr bool operator>=(const BasicFraction<Int>& other) const;
+    // @brief Return -1, 0 or 1 as this is less than, equal to or greater than other
+    constexpr int compare(const BasicFraction<Int>& other) const;
+
+    constexpr Int get_numerator() const;
+    constexpr UInt get_denominator() const;
 
     // convert Fraction to other types
-    double to_double() const;
+    constexpr double to_double() const;
     std::string to_string() const;
 
-    // convert Fraction from other types
-    void from_string(const std::string& str);
-    void from_decimal_string(const std::string& str);
+    // convert Fraction from other types. Both accept every syntax of from_chars, after leading
+    // whitespace, and ignore the characters after it. They throw std::invalid_argument if
+    // there is no fraction, std::out_of_range if it does not fit, and an exception if the
+    // denominator is zero.
+    void from_string(std::string_view str);
+    void from_decimal_string(std::string_view str);
+
+    // convert Fraction from a double. A finite double is an integer times a power of two, so
+    // from_double(x) is exact, with a power of two as the denominator, and throws
+    // std::out_of_range if that does not fit in Int (as for most doubles with a 32-bit Int).
+    // from_double(x, max_denominator) is the fraction closest to x with a denominator of at
+    // most max_denominator, e.g. 0.1 with 1000 gives 1/10, found with the continued fraction
+    // of x; it throws std::out_of_range only if the integer part of x does not fit, and
+    // std::invalid_argument if max_denominator is zero. Both throw std::invalid_argument for
+    // NaN and std::out_of_range for infinity. The message of each exception gives the reason.
+    void from_double(double x);
+    void from_double(double x, UInt max_denominator);
+};
+
+// Parse and format fractions like std::from_chars and std::to_chars: over a range of characters,
+// without allocating, and reporting errors in the result instead of throwing.
+// from_chars reads "a/b", an integer, or a decimal with an optional exponent ("-1.05", ".5",
+// "2.5e-3"), and stops at the first character that does not fit the syntax. ec is
+// std::errc::invalid_argument if there is no fraction at first, std::errc::result_out_of_range
+// if it does not fit in Int, and std::errc::argument_out_of_domain if the denominator is zero;
+// on error, value is left unchanged.
+// to_chars writes the same text as to_string, at most max_chars characters, or returns
+// std::errc::value_too_large if it does not fit in [first, last).
+template<class Int> std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<Int>& value);
+template<class Int> std::to_chars_result to_chars(char* first, char* last, const BasicFraction<Int>& value);
+
+// Convert the doubles in [first, last) to out[0], out[1], ... like from_double, exactly or with
+// the given maximum denominator. If one of them throws, the elements before it are converted.
+template<class Int> void from_doubles(const double* first, const double* last, BasicFraction<Int>* out);
+template<class Int> void from_doubles(const double* first, const double* last, BasicFraction<Int>* out,
+                                      typename fraction_detail::int_traits<Int>::unsigned_type max_denominator);
+
+// input/output stream
+template<class Int> std::istream& operator>>(std::istream& is, BasicFraction<Int>& f);
+template<class Int> std::ostream& operator<<(std::ostream& os, const BasicFraction<Int>& f);
+
+typedef BasicFraction<int32_t> Fraction;
+typedef BasicFraction<int64_t> Fraction64;
+typedef BasicFraction<__int128> Fraction128;
+
+// The members that are not constexpr are defined in fraction.cpp for these three types only
+extern template class BasicFraction<int32_t>;
+extern template class BasicFraction<int64_t>;
+extern template class BasicFraction<__int128>;
+
+extern template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<int32_t>& value);
+extern template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<int64_t>& value);
+extern template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<__int128>& value);
+extern template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<int32_t>& value);
+extern template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<int64_t>& value);
+extern template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<__int128>& value);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<int32_t>* out);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<int64_t>* out);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<__int128>* out);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<int32_t>* out, uint32_t max_denominator);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<int64_t>* out, uint64_t max_denominator);
+extern template void from_doubles(const double* first, const double* last, BasicFraction<__int128>* out, unsigned __int128 max_denominator);
+extern template std::istream& operator>>(std::istream& is, BasicFraction<int32_t>& f);
+extern template std::istream& operator>>(std::istream& is, BasicFraction<int64_t>& f);
+extern template std::istream& operator>>(std::istream& is, BasicFraction<__int128>& f);
+extern template std::ostream& operator<<(std::ostream& os, const BasicFraction<int32_t>& f);
+extern template std::ostream& operator<<(std::ostream& os, const BasicFraction<int64_t>& f);
+extern template std::ostream& operator<<(std::ostream& os, const BasicFraction<__int128>& f);
+
+// @brief Reduce numerator/denominator in the wider type W, and store it if it fits in Int.
+//        Otherwise throw an exception.
+template<class Int>
+template<class W>
+constexpr BasicFraction<Int> BasicFraction<Int>::narrow(W numerator, W denominator) {
+    BasicFraction<W> wide(numerator, denominator);
+    if (wide.numerator > static_cast<W>(traits::max) || wide.numerator < -static_cast<W>(traits::max) ||
+        wide.denominator > static_cast<typename BasicFraction<W>::UInt>(traits::max)) {
+        throw "Fraction overflow";
+    }
+
+    BasicFraction<Int> result;
+    result.numerator = static_cast<Int>(wide.numerator);
+    result.denominator = static_cast<UInt>(wide.denominator);
+    return result;
+}
+
+// @brief Store magnitudes that are already coprime, with the given sign, if they fit in Int.
+//        Otherwise throw an exception.
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::from_reduced(UInt numerator, UInt denominator, bool negative) {
+    if (numerator > static_cast<UInt>(traits::max) || denominator > static_cast<UInt>(traits::max)) {
+        throw "Fraction overflow";
+    }
+    BasicFraction<Int> result;
+    result.numerator = negative ? -static_cast<Int>(numerator) : static_cast<Int>(numerator);
+    result.denominator = denominator;
+    return result;
+}
+
+// @brief Move the sign to the numerator and reduce the fraction to lowest terms.
+//        The magnitudes are reduced as unsigned numbers, so that INT_MIN is accepted when the
+//        reduced fraction fits; if it does not, throw an exception
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::reduce(Int numerator, Int denominator) {
+    if (denominator == 0) {
+        throw "Denominator cannot be zero";
+    }
+    UInt n = fraction_detail::magnitude(numerator), d = fraction_detail::magnitude(denominator);
+    UInt gcd_val = fraction_detail::gcd(n, d);
+    return from_reduced(n / gcd_val, d / gcd_val, (numerator < 0) != (denominator < 0));
+}
+
+// @brief std::ratio keeps its parts in lowest terms with a positive denominator, in intmax_t:
+//        they only have to be checked against the range of Int
+template<class Int>
+template<class R>
+constexpr BasicFraction<Int> BasicFraction<Int>::from_ratio() {
+    if constexpr (sizeof(Int) > sizeof(std::intmax_t)) {
+        return BasicFraction<Int>(BasicFraction<std::intmax_t>(R::num, R::den));
+    } else {
+        return narrow<std::intmax_t>(R::num, R::den);
+    }
+}
+
+// Constructors
+
+// Default constructor: Set fraction to 0
+template<class Int>
+constexpr BasicFraction<Int>::BasicFraction(): numerator(0), denominator(1) {}
+
+// Constructor with numerator and denominator
+// If denominator is zero, throw an exception
+// Automatically move the sign to the numerator and reduce the fraction to lowest terms
+template<class Int>
+constexpr BasicFraction<Int>::BasicFraction(Int numerator, Int denominator)
+    : BasicFraction(reduce(numerator, denominator)) {}
+
+// Constructor with numerator, denominator, and sign
+// If denominator is zero, throw an exception
+// The signs of numerator and denominator are ignored: the fraction is |numerator / denominator|
+// with the sign of sign, and zero if sign is zero
+// Automatically reduce the fraction to lowest terms
+template<class Int>
+constexpr BasicFraction<Int>::BasicFraction(Int numerator, Int denominator, int sign)
+    : BasicFraction(sign == 0 ? static_cast<Int>(0) : numerator, denominator) {
+    if ((this->numerator < 0) != (sign < 0)) {
+        this->numerator = -this->numerator;
+    }
+}
+
+template<class Int>
+template<class Narrow, class>
+constexpr BasicFraction<Int>::BasicFraction(const BasicFraction<Narrow>& other)
+    : numerator(other.numerator), denominator(other.denominator) {}
+
+template<class Int>
+template<std::intmax_t N, std::intmax_t D>
+constexpr BasicFraction<Int>::BasicFraction(std::ratio<N, D>)
+    : BasicFraction(from_ratio<std::ratio<N, D>>()) {}
+
+// Arthematical operators
+
+// @brief Compute this + other.
+//        The common denominator is lcm(b, d) = b / g * d with g = gcd(b, d). If a product or the
+//        sum overflows Int, everything is recomputed in the wider type, where it cannot.
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::operator+(const BasicFraction<Int>& other) const {
+    // The denominators are at most max, so they and their quotients fit in Int
+    Int gcd_val = static_cast<Int>(fraction_detail::gcd(denominator, other.denominator));
+    Int b = static_cast<Int>(denominator), d = static_cast<Int>(other.denominator);
+    Int new_denominator = 0, left = 0, right = 0, new_numerator = 0;
+    if (!__builtin_mul_overflow(b / gcd_val, d, &new_denominator) &&
+        !__builtin_mul_overflow(numerator, d / gcd_val, &left) &&
+        !__builtin_mul_overflow(other.numerator, b / gcd_val, &right) &&
+        !__builtin_add_overflow(left, right, &new_numerator)) {
+        // The constructor will reduce the fraction automatically
+        return BasicFraction<Int>(new_numerator, new_denominator);
+    }
+
+    if constexpr (!std::is_void<Wide>::value) {
+        Wide wide_denominator = static_cast<Wide>(b / gcd_val) * d;
+        Wide wide_numerator = static_cast<Wide>(numerator) * (d / gcd_val)
+                            + static_cast<Wide>(other.numerator) * (b / gcd_val);
+        return narrow(wide_numerator, wide_denominator);
+    }
+    throw "Fraction overflow";
+}
+
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::operator-(const BasicFraction<Int>& other) const {
+    BasicFraction<Int> negated = other;
+    negated.numerator = -negated.numerator;
+    return *this + negated;
+}
+
+// @brief a/b * c/d, cross-reducing first: with g1 = gcd(a, d) and g2 = gcd(c, b), the products
+//        (a / g1) * (c / g2) and (b / g2) * (d / g1) are already coprime. They need no further
+//        reduction, and if one of them overflows Int, the result does not fit in Int.
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::operator*(const BasicFraction<Int>& other) const {
+    if (numerator == 0 || other.numerator == 0) {
+        return BasicFraction<Int>();
+    }
+    UInt a = fraction_detail::magnitude(numerator), c = fraction_detail::magnitude(other.numerator);
+    UInt gcd1 = fraction_detail::gcd(a, other.denominator);
+    UInt gcd2 = fraction_detail::gcd(c, denominator);
+
+    UInt new_numerator = 0, new_denominator = 0;
+    if (__builtin_mul_overflow(a / gcd1, c / gcd2, &new_numerator) ||
+        __builtin_mul_overflow(denominator / gcd2, other.denominator / gcd1, &new_denominator)) {
+        throw "Fraction overflow";
+    }
+    return from_reduced(new_numerator, new_denominator, (numerator < 0) != (other.numerator < 0));
+}
+
+// @brief a/b / c/d = a/b * d/c, cross-reduced the same way
+template<class Int>
+constexpr BasicFraction<Int> BasicFraction<Int>::operator/(const BasicFraction<Int>& other) const {
+    if (other.numerator == 0) {
+        throw "Denominator cannot be zero";
+    }
+    if (numerator == 0) {
+        return BasicFraction<Int>();
+    }
+    UInt a = fraction_detail::magnitude(numerator), c = fraction_detail::magnitude(other.numerator);
+    UInt gcd1 = fraction_detail::gcd(a, c);
+    UInt gcd2 = fraction_detail::gcd(other.denominator, denominator);
+
+    UInt new_numerator = 0, new_denominator = 0;
+    if (__builtin_mul_overflow(a / gcd1, other.denominator / gcd2, &new_numerator) ||
+        __builtin_mul_overflow(denominator / gcd2, c / gcd1, &new_denominator)) {
+        throw "Fraction overflow";
+    }
+    return from_reduced(new_numerator, new_denominator, (numerator < 0) != (other.numerator < 0));
+}
+
+// Comparison operators
+template<class Int>
+constexpr bool BasicFraction<Int>::operator==(const BasicFraction<Int>& other) const {
+    // Since the fractions are canonical, we only need to compare the numerators and denominators
+    return numerator == other.numerator && denominator == other.denominator;
+}
+
+template<class Int>
+constexpr bool BasicFraction<Int>::operator!=(const BasicFraction<Int>& other) const {
+    return !(*this == other);
+}
+
+// @brief Three-way comparison. The denominators are positive, so a/b < c/d if and only if
+//        a * d < c * b. The products are computed in twice the width of Int, which cannot
+//        overflow, so no gcd or common denominator is needed.
+template<class Int>
+constexpr int BasicFraction<Int>::compare(const BasicFraction<Int>& other) const {
+    if constexpr (!std::is_void<Wide>::value) {
+        Wide product1 = static_cast<Wide>(numerator) * other.denominator;
+        Wide product2 = static_cast<Wide>(other.numerator) * denominator;
+        return (product1 > product2) - (product1 < product2);
+    } else {
+        // There is no signed 256-bit type: the signs decide first, then the magnitudes
+        int sign = fraction_detail::sgn(numerator), other_sign = fraction_detail::sgn(other.numerator);
+        if (sign != other_sign) {
+            return sign < other_sign ? -1 : 1;
+        }
+        // If both fractions are negative, the fraction with larger absolute value is smaller
+        return sign * fraction_detail::compare_products(fraction_detail::magnitude(numerator), other.denominator,
+                                                        fraction_detail::magnitude(other.numerator), denominator);
+    }
+}
+
+template<class Int>
+constexpr bool BasicFraction<Int>::operator<(const BasicFraction<Int>& other) const {
+    return compare(other) < 0;
+}
+
+template<class Int>
+constexpr bool BasicFraction<Int>::operator<=(const BasicFraction<Int>& other) const {
+    return compare(other) <= 0;
+}
+
+template<class Int>
+constexpr bool BasicFraction<Int>::operator>(const BasicFraction<Int>& other) const {
+    return compare(other) > 0;
+}
+
+template<class Int>
+constexpr bool BasicFraction<Int>::operator>=(const BasicFraction<Int>& other) const {
+    return compare(other) >= 0;
+}
+
+template<class Int>
+constexpr Int BasicFraction<Int>::get_numerator() const {
+    return numerator;
+}
+
+template<class Int>
+constexpr typename BasicFraction<Int>::UInt BasicFraction<Int>::get_denominator() const {
+    return denominator;
+}
+
+// @brief Convert Fraction to a double
+template<class Int>
+constexpr double BasicFraction<Int>::to_double() const {
+    return static_cast<double>(numerator) / static_cast<double>(denominator);
+}
+
+// The std::ratio of a constexpr fraction with static storage duration, if its parts fit in
+// intmax_t, e.g. with static constexpr Fraction third(1, 3), fraction_ratio<third> is
+// std::ratio<1, 3>
+template<const auto& F>
+using fraction_ratio = std::ratio<F.get_numerator(), F.get_denominator()>;
+
+#if __cpp_impl_three_way_comparison >= 201907L
+// A free function defined here rather than a member defined in fraction.cpp, so that it is
+// available to C++20 code even though fraction.cpp is compiled as C++17
+template<class Int>
+constexpr std::strong_ordering operator<=>(const BasicFraction<Int>& a, const BasicFraction<Int>& b) {
+    return a.compare(b) <=> 0;
+}
+#endif
+
+// Fractions are canonical, so equal fractions have equal parts and hash alike
+namespace std {
+
+template<class Int>
+struct hash<BasicFraction<Int>> {
+    size_t operator()(const BasicFraction<Int>& f) const noexcept {
+        typedef typename fraction_detail::int_traits<Int>::unsigned_type UInt;
+        return fraction_detail::hash_parts(static_cast<UInt>(f.get_numerator()), f.get_denominator());
+    }
 };
 
+}   // namespace std
+
 #endif
@@ -0,0 +1,66 @@
+#ifndef __FRACTION_ACCUMULATOR_H__
+#define __FRACTION_ACCUMULATOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "fraction.h"
+
+// Running sum of many fractions. Fraction's operator+ takes a gcd for the common denominator
+// and another one to reduce the result at every step; the accumulator instead keeps an
+// unreduced 128-bit numerator over the least common multiple of the denominators added so far,
+// in 63 bits. Once that denominator is a multiple of the next one, as it soon is when the
+// denominators are small, an addition is a multiplication and an addition. The sum is only
+// reduced when the next step would overflow, and when it is read.
+// Sums of separate ranges, e.g. one per thread, are combined with merge().
+class FractionAccumulator {
+private:
+    // Denominators below this have their quotient cached
+    static const uint32_t cached_denominators = 64;
+    // The running denominator stays within the range of int64_t, like that of a Fraction64,
+    // so that the binary gcd can take it
+    static const uint64_t max_denominator = 0x7fffffffffffffffull;
+
+    __int128 numerator;
+    uint64_t denominator;
+    // quotients[b] = denominator / b for each small b added since the denominator last
+    // changed, or 0 if it is not known yet
+    uint64_t quotients[cached_denominators];
+
+    // @brief Add numerator/denominator over the lcm of both denominators. If that overflows,
+    //        reduce the running sum and retry; failing that, add in Fraction128 and reduce, and
+    //        throw an exception if the reduced sum still does not fit.
+    void add_slow(__int128 numerator, uint64_t denominator);
+
+    // @brief Reduce the running sum to lowest terms, return whether it changed
+    bool normalize();
+
+    // @brief Add the canonical fraction numerator/denominator of 32-bit parts
+    void add(int32_t numerator, uint32_t denominator);
+
+    // FractionArray adds its columns without building a Fraction for each element
+    friend class FractionArray;
+
+public:
+    FractionAccumulator();
+
+    void add(const Fraction& value);
+    void add(const Fraction64& value);
+    FractionAccumulator& operator+=(const Fraction& value);
+    FractionAccumulator& operator+=(const Fraction64& value);
+
+    // @brief Add the sum accumulated by other
+    void merge(const FractionAccumulator& other);
+
+    // @brief Reset the sum to zero
+    void clear();
+
+    // @brief The sum so far, in lowest terms
+    Fraction128 sum() const;
+
+    // @brief The sum of values, split into one range per thread. Each thread accumulates its
+    //        range, and the partial sums are merged in order at the end.
+    static Fraction128 parallel_sum(const std::vector<Fraction>& values, unsigned threads);
+};
+
+#endif
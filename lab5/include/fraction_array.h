@@ -0,0 +1,61 @@
+#ifndef __FRACTION_ARRAY_H__
+#define __FRACTION_ARRAY_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "fraction.h"
+
+// Array of Fractions stored as two columns, the numerators and the denominators, for bulk
+// arithmetic. An element-wise operation runs over blocks of elements: it computes the gcds of a
+// whole block at once with a vectorized binary gcd, divides by them with vectorized exact
+// divisions, and only then combines the parts, instead of one Fraction operation at a time.
+// Every element is canonical, like a Fraction: the sign on the numerator, a positive
+// denominator, coprime, with zero stored as 0/1.
+class FractionArray {
+private:
+    std::vector<int32_t> numerators;
+    std::vector<uint32_t> denominators;
+
+    // @brief Throw an exception if other does not have the same size
+    void check_size(const FractionArray& other) const;
+
+    // @brief Add other, or subtract it if subtract is set, element-wise and in place
+    FractionArray& add(const FractionArray& other, bool subtract);
+
+public:
+    FractionArray();
+    // An array of size zeros
+    explicit FractionArray(std::size_t size);
+    FractionArray(const std::vector<Fraction>& values);
+
+    std::size_t size() const;
+    Fraction get(std::size_t index) const;
+    void set(std::size_t index, const Fraction& value);
+    void push_back(const Fraction& value);
+    std::vector<Fraction> to_vector() const;
+
+    // element-wise arthematical operators, both arrays must have the same size
+    FractionArray operator+(const FractionArray& other) const;
+    FractionArray operator-(const FractionArray& other) const;
+    FractionArray operator*(const FractionArray& other) const;
+    FractionArray operator/(const FractionArray& other) const;
+
+    // element-wise compound assignment, computed in place block by block. If an element
+    // overflows, an exception is thrown and only the blocks before it have been updated,
+    // so every element is still a valid fraction.
+    FractionArray& operator+=(const FractionArray& other);
+    FractionArray& operator-=(const FractionArray& other);
+    FractionArray& operator*=(const FractionArray& other);
+    FractionArray& operator/=(const FractionArray& other);
+
+    // @brief The sum of all the elements, added with a FractionAccumulator, in 128 bits since
+    //        it often outgrows 32
+    Fraction128 sum() const;
+
+    // @brief Element-wise three-way comparison: -1, 0 or 1 as each element is less than,
+    //        equal to or greater than the element of other at the same index
+    std::vector<int> compare(const FractionArray& other) const;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef __RATIONAL_MATRIX_H__
+#define __RATIONAL_MATRIX_H__
+
+#include <cstddef>
+#include <vector>
+#include "big_fraction.h"
+#include "fraction.h"
+
+// Matrix of exact rationals for solving linear systems. The entries are BigFractions, so
+// determinants and inverses never overflow.
+// Elimination does not work on fractions: each row is scaled by the lcm of its denominators
+// to an integer row, and the integer matrix is eliminated with Bareiss' fraction-free
+// algorithm. A step replaces a[i][j] by (p * a[i][j] - a[i][c] * a[r][j]) / q, with p the
+// current pivot and q the previous one. The division is exact and every entry stays a minor of
+// the matrix, so the integers grow only as fast as the determinant. Fractions are built once,
+// at the end, with one division by the last pivot. The rows of an elimination step are
+// independent and are updated in parallel when the matrix is large.
+class RationalMatrix {
+private:
+    std::size_t rows, cols;
+    std::vector<BigFraction> entries;   // row-major
+
+    // @brief Throw an exception if the matrix is not square
+    void check_square() const;
+
+public:
+    // The number of threads an elimination step runs on, when there are enough entries to
+    // update; 0 or 1 eliminates on the calling thread
+    static unsigned threads;
+
+    RationalMatrix();
+    // A rows x cols matrix of zeros
+    RationalMatrix(std::size_t rows, std::size_t cols);
+    // A matrix from its rows, which must all have the same length
+    RationalMatrix(const std::vector<std::vector<Fraction>>& values);
+
+    // @brief The n x n identity matrix
+    static RationalMatrix identity(std::size_t n);
+
+    std::size_t row_count() const;
+    std::size_t col_count() const;
+    const BigFraction& get(std::size_t row, std::size_t col) const;
+    void set(std::size_t row, std::size_t col, const BigFraction& value);
+
+    // overload arthematical operators, the sizes must match
+    RationalMatrix operator*(const RationalMatrix& other) const;
+
+    // overload comparison operators
+    bool operator==(const RationalMatrix& other) const;
+    bool operator!=(const RationalMatrix& other) const;
+
+    // @brief The reduced row echelon form, by Gauss-Jordan elimination
+    RationalMatrix row_echelon() const;
+
+    // @brief The number of linearly independent rows
+    std::size_t rank() const;
+
+    // @brief The determinant of a square matrix
+    BigFraction determinant() const;
+
+    // @brief The inverse of a square matrix. Throw an exception if it is singular.
+    RationalMatrix inverse() const;
+
+    // @brief The solution X of this * X = rhs, for a square, nonsingular matrix and a
+    //        right-hand side with the same number of rows (one column per system)
+    RationalMatrix solve(const RationalMatrix& rhs) const;
+};
+
+// output stream, on one line with the rows separated by semicolons: [1 1/2; 0 1]
+std::ostream& operator<<(std::ostream& os, const RationalMatrix& m);
+
+#endif
@@ -2,4 +2,13 @@
 
 ./compile.sh
 
-./build/lab5 < test/case1.in
+for case in test/*.in; do
+    ./build/lab5 < "$case"
+done
+
+# Any undefined behaviour in the same cases aborts the run
+for case in test/*.in; do
+    ./build/lab5_ubsan < "$case" > /dev/null || exit 1
+done
+
+./build/fraction_stream -q test/stream.txt
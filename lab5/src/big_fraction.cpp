@@ -0,0 +1,228 @@
+#include "big_fraction.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Helper functions
+namespace {
+
+// @brief Compute 10^exp
+BigInteger power_of_ten(std::size_t exp) {
+    const long long chunk = 1000000000000000000ll;  // 10^18
+    BigInteger result = 1;
+    for (; exp >= 18; exp -= 18) {
+        result = result * chunk;
+    }
+    long long rest = 1;
+    for (; exp > 0; exp--) {
+        rest *= 10;
+    }
+    return result * rest;
+}
+
+}   // namespace
+
+// @brief Reduce the fraction to lowest terms and move the sign to the numerator
+void BigFraction::reduce() {
+    if (denominator.is_zero()) {
+        throw "Denominator cannot be zero";
+    }
+    if (denominator.sign() < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+
+    BigInteger gcd_val = BigInteger::gcd(numerator, denominator);
+    if (gcd_val != 1) {
+        numerator = numerator / gcd_val;
+        denominator = denominator / gcd_val;
+    }
+}
+
+// Constructors
+
+// Default constructor: Set fraction to 0
+BigFraction::BigFraction(): numerator(0), denominator(1) {}
+
+// Constructor with numerator and denominator
+// If denominator is zero, throw an exception
+// Automatically move the sign to the numerator and reduce the fraction to lowest terms
+BigFraction::BigFraction(const BigInteger& numerator, const BigInteger& denominator)
+    : numerator(numerator), denominator(denominator) {
+    reduce();
+}
+
+BigFraction::BigFraction(long long numerator, long long denominator)
+    : BigFraction(BigInteger(numerator), BigInteger(denominator)) {}
+
+// Arthematical operators
+
+// @brief a/b + c/d, reducing with the small gcd of the denominators first (Knuth, 4.5.1):
+//        with g = gcd(b, d) and t = a * (d / g) + c * (b / g), the result is
+//        (t / g2) / ((b / g) * (d / g2)) where g2 = gcd(t, g). Both gcds involve g, which
+//        is usually much smaller than the operands.
+BigFraction BigFraction::operator+(const BigFraction& other) const {
+    BigFraction result;
+    BigInteger g = BigInteger::gcd(denominator, other.denominator);
+    if (g == 1) {
+        result.numerator = numerator * other.denominator + other.numerator * denominator;
+        result.denominator = denominator * other.denominator;
+        return result;
+    }
+
+    BigInteger b = denominator / g;
+    BigInteger t = numerator * (other.denominator / g) + other.numerator * b;
+    BigInteger g2 = BigInteger::gcd(t, g);
+    if (g2 == 1) {
+        result.numerator = t;
+        result.denominator = b * other.denominator;
+    } else {
+        result.numerator = t / g2;
+        result.denominator = b * (other.denominator / g2);
+    }
+    if (result.numerator.is_zero()) {
+        result.denominator = 1;
+    }
+    return result;
+}
+
+BigFraction BigFraction::operator-(const BigFraction& other) const {
+    BigFraction negated = other;
+    negated.numerator = -negated.numerator;
+    return *this + negated;
+}
+
+// @brief a/b * c/d, cross-reducing first: with g1 = gcd(a, d) and g2 = gcd(c, b), the result
+//        (a / g1) * (c / g2) / ((b / g2) * (d / g1)) is already in lowest terms.
+BigFraction BigFraction::operator*(const BigFraction& other) const {
+    BigFraction result;
+    if (numerator.is_zero() || other.numerator.is_zero()) {
+        return result;
+    }
+    BigInteger g1 = BigInteger::gcd(numerator, other.denominator);
+    BigInteger g2 = BigInteger::gcd(other.numerator, denominator);
+    result.numerator = (numerator / g1) * (other.numerator / g2);
+    result.denominator = (denominator / g2) * (other.denominator / g1);
+    return result;
+}
+
+BigFraction BigFraction::operator/(const BigFraction& other) const {
+    if (other.numerator.is_zero()) {
+        throw "Denominator cannot be zero";
+    }
+    BigFraction reciprocal;
+    reciprocal.numerator = other.numerator.sign() < 0 ? -other.denominator : other.denominator;
+    reciprocal.denominator = other.numerator.abs();
+    return *this * reciprocal;
+}
+
+// Comparison operators
+bool BigFraction::operator==(const BigFraction& other) const {
+    // Since the fractions are reduced, we only need to compare the numerators and denominators
+    return numerator == other.numerator && denominator == other.denominator;
+}
+
+bool BigFraction::operator!=(const BigFraction& other) const {
+    return !(*this == other);
+}
+
+bool BigFraction::operator<(const BigFraction& other) const {
+    // Different signs decide without multiplying
+    if (numerator.sign() != other.numerator.sign()) {
+        return numerator.sign() < other.numerator.sign();
+    }
+    // The denominators are positive, so a/b < c/d if and only if a * d < c * b
+    return numerator * other.denominator < other.numerator * denominator;
+}
+
+bool BigFraction::operator<=(const BigFraction& other) const {
+    return !(other < *this);
+}
+
+bool BigFraction::operator>(const BigFraction& other) const {
+    return other < *this;
+}
+
+bool BigFraction::operator>=(const BigFraction& other) const {
+    return !(*this < other);
+}
+
+const BigInteger& BigFraction::get_numerator() const {
+    return numerator;
+}
+
+const BigInteger& BigFraction::get_denominator() const {
+    return denominator;
+}
+
+// @brief Convert BigFraction to a double.
+//        The numerator and the denominator are first cut to their leading 64 bits, so that
+//        fractions of huge numbers (whose parts are out of the range of double) still convert.
+double BigFraction::to_double() const {
+    long long numerator_shift = std::max(0ll, numerator.bit_length() - 64);
+    long long denominator_shift = std::max(0ll, denominator.bit_length() - 64);
+    double n = (numerator >> static_cast<int>(numerator_shift)).to_double();
+    double d = (denominator >> static_cast<int>(denominator_shift)).to_double();
+    return std::ldexp(n / d, static_cast<int>(numerator_shift - denominator_shift));
+}
+
+// @brief Convert BigFraction to a string (fraction)
+std::string BigFraction::to_string() const {
+    // If the denominator is 1, the denominator will be omitted
+    if (denominator == 1) {
+        return numerator.to_string();
+    }
+    return numerator.to_string() + "/" + denominator.to_string();
+}
+
+// @brief Convert a string (fraction) to BigFraction
+void BigFraction::from_string(const std::string& str) {
+    std::size_t slash_pos = str.find('/');
+    if (slash_pos == std::string::npos) {
+        // If no slash is found, the fraction is an integer
+        numerator.from_string(str);
+        denominator = 1;
+    } else {
+        // If a slash is found, parse the numerator and denominator respectively
+        numerator.from_string(str.substr(0, slash_pos));
+        denominator.from_string(str.substr(slash_pos + 1));
+    }
+
+    // Reduce the fraction to lowest terms
+    reduce();
+}
+
+// @brief Convert a string (decimal) to BigFraction: the digits without the dot, over 10^(number of decimals)
+void BigFraction::from_decimal_string(const std::string& str) {
+    std::size_t dot_pos = str.find('.');
+    if (dot_pos == std::string::npos) {
+        numerator.from_string(str);
+        denominator = 1;
+    } else {
+        std::string digits = str.substr(0, dot_pos) + str.substr(dot_pos + 1);
+        numerator.from_string(digits);
+        denominator = power_of_ten(str.size() - dot_pos - 1);
+    }
+
+    // Reduce the fraction to lowest terms
+    reduce();
+}
+
+// Overload the << and >> operators for output and input
+std::ostream& operator<<(std::ostream& os, const BigFraction& f) {
+    os << f.to_string();
+    return os;
+}
+
+std::istream& operator>>(std::istream& is, BigFraction& f) {
+    std::string str;
+    is >> str;
+
+    // Try to parse the string as a fraction first, then as a decimal
+    if (str.find('/') != std::string::npos) {
+        f.from_string(str);
+    } else {
+        f.from_decimal_string(str);
+    }
+    return is;
+}
@@ -0,0 +1,617 @@
+#include "big_integer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+int BigInteger::karatsuba_threshold = 64;
+
+// Helper functions on magnitudes: vectors of limbs, least significant first
+namespace {
+
+typedef std::vector<uint64_t> Limbs;
+typedef unsigned __int128 uint128;
+
+// 10^19, the largest power of ten that fits in a limb
+const uint64_t DECIMAL_BASE = 10000000000000000000ull;
+const int DECIMAL_DIGITS = 19;
+
+// @brief Remove the leading zero limbs
+void trim(Limbs& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+// @brief Compare two magnitudes, return -1, 0 or 1
+int compare_magnitude(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (std::size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// @brief Compute a + b
+Limbs add_magnitude(const Limbs& a, const Limbs& b) {
+    const Limbs& longer = a.size() >= b.size() ? a : b;
+    const Limbs& shorter = a.size() >= b.size() ? b : a;
+    Limbs result(longer.size() + 1);
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < longer.size(); i++) {
+        uint128 sum = static_cast<uint128>(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+        result[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    result[longer.size()] = carry;
+    trim(result);
+    return result;
+}
+
+// @brief Subtract b from a in place, where a >= b
+void sub_in_place(Limbs& a, const Limbs& b, std::size_t offset = 0) {
+    uint64_t borrow = 0;
+    for (std::size_t i = 0; i < b.size() || borrow; i++) {
+        uint64_t sub = (i < b.size() ? b[i] : 0);
+        uint64_t x = a[i + offset];
+        uint64_t d = x - sub - borrow;
+        borrow = (x < sub) || (x - sub < borrow);
+        a[i + offset] = d;
+    }
+    trim(a);
+}
+
+// @brief Compute a - b, where a >= b
+Limbs sub_magnitude(const Limbs& a, const Limbs& b) {
+    Limbs result = a;
+    sub_in_place(result, b);
+    return result;
+}
+
+// @brief Add b * B^offset to a in place; a must be long enough to hold the sum
+void add_in_place(Limbs& a, const Limbs& b, std::size_t offset) {
+    uint64_t carry = 0;
+    for (std::size_t i = 0; i < b.size() || carry; i++) {
+        uint128 sum = static_cast<uint128>(a[i + offset]) + (i < b.size() ? b[i] : 0) + carry;
+        a[i + offset] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+}
+
+// @brief Compute a * m + add in place
+void mul_add_small(Limbs& a, uint64_t m, uint64_t add) {
+    uint64_t carry = add;
+    for (uint64_t& limb : a) {
+        uint128 product = static_cast<uint128>(limb) * m + carry;
+        limb = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+    }
+    if (carry != 0) {
+        a.push_back(carry);
+    }
+    trim(a);
+}
+
+// @brief Compute a * m
+Limbs mul_small(const Limbs& a, uint64_t m) {
+    Limbs result = a;
+    mul_add_small(result, m, 0);
+    return result;
+}
+
+// @brief Divide a by d in place, return the remainder
+uint64_t divmod_small(Limbs& a, uint64_t d) {
+    uint64_t remainder = 0;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        uint128 current = (static_cast<uint128>(remainder) << 64) | a[i];
+        a[i] = static_cast<uint64_t>(current / d);
+        remainder = static_cast<uint64_t>(current % d);
+    }
+    trim(a);
+    return remainder;
+}
+
+// @brief Return a mod d without modifying a
+uint64_t mod_small(const Limbs& a, uint64_t d) {
+    uint64_t remainder = 0;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        remainder = static_cast<uint64_t>(((static_cast<uint128>(remainder) << 64) | a[i]) % d);
+    }
+    return remainder;
+}
+
+// @brief Shift a left by 0 <= bits < 64 into a buffer with one more limb
+Limbs shift_left_bits(const Limbs& a, int bits) {
+    Limbs result(a.size() + 1);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        result[i] |= a[i] << bits;
+        result[i + 1] = bits == 0 ? 0 : a[i] >> (64 - bits);
+    }
+    return result;
+}
+
+// @brief Multiply a[0, na) by b[0, nb) with the schoolbook algorithm into out[0, na + nb), which must be zero
+void mul_schoolbook(const uint64_t *a, std::size_t na, const uint64_t *b, std::size_t nb, uint64_t *out) {
+    for (std::size_t i = 0; i < na; i++) {
+        uint64_t carry = 0;
+        for (std::size_t j = 0; j < nb; j++) {
+            uint128 product = static_cast<uint128>(a[i]) * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        out[i + nb] = carry;
+    }
+}
+
+// @brief Multiply a[0, na) by b[0, nb) with Karatsuba's algorithm, falling back to the schoolbook
+//        algorithm below the threshold. a1 * b1, a0 * b0 and (a0 + a1) * (b0 + b1) give the
+//        three parts of the product with three half-size multiplications instead of four.
+Limbs mul_karatsuba(const uint64_t *a, std::size_t na, const uint64_t *b, std::size_t nb) {
+    while (na > 0 && a[na - 1] == 0) na--;
+    while (nb > 0 && b[nb - 1] == 0) nb--;
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0) {
+        return Limbs();
+    }
+
+    Limbs result(na + nb);
+    if (nb < static_cast<std::size_t>(BigInteger::karatsuba_threshold)) {
+        mul_schoolbook(a, na, b, nb, result.data());
+        trim(result);
+        return result;
+    }
+
+    std::size_t half = (na + 1) / 2;
+    if (nb <= half) {
+        // b is much shorter: a * b = a1 * b * B^half + a0 * b
+        add_in_place(result, mul_karatsuba(a, half, b, nb), 0);
+        add_in_place(result, mul_karatsuba(a + half, na - half, b, nb), half);
+        trim(result);
+        return result;
+    }
+
+    Limbs a0(a, a + half), a1(a + half, a + na), b0(b, b + half), b1(b + half, b + nb);
+    trim(a0);
+    trim(b0);
+    Limbs low = mul_karatsuba(a0.data(), a0.size(), b0.data(), b0.size());
+    Limbs high = mul_karatsuba(a1.data(), a1.size(), b1.data(), b1.size());
+    Limbs sum_a = add_magnitude(a0, a1), sum_b = add_magnitude(b0, b1);
+    Limbs middle = mul_karatsuba(sum_a.data(), sum_a.size(), sum_b.data(), sum_b.size());
+    sub_in_place(middle, low);
+    sub_in_place(middle, high);
+
+    add_in_place(result, low, 0);
+    add_in_place(result, middle, half);
+    add_in_place(result, high, 2 * half);
+    trim(result);
+    return result;
+}
+
+// @brief Compute a * b
+Limbs mul_magnitude(const Limbs& a, const Limbs& b) {
+    return mul_karatsuba(a.data(), a.size(), b.data(), b.size());
+}
+
+// @brief Divide u by v (v not zero) with Knuth's algorithm D
+void divmod_magnitude(const Limbs& u, const Limbs& v, Limbs& quotient, Limbs& remainder) {
+    if (compare_magnitude(u, v) < 0) {
+        quotient.clear();
+        remainder = u;
+        return;
+    }
+    if (v.size() == 1) {
+        quotient = u;
+        remainder.clear();
+        uint64_t r = divmod_small(quotient, v[0]);
+        if (r != 0) {
+            remainder.push_back(r);
+        }
+        return;
+    }
+
+    // Normalize so that the top limb of the divisor has its highest bit set
+    std::size_t n = v.size(), m = u.size() - v.size();
+    int shift = __builtin_clzll(v.back());
+    Limbs vn = shift_left_bits(v, shift);
+    vn.pop_back();
+    Limbs un = shift_left_bits(u, shift);
+
+    quotient.assign(m + 1, 0);
+    for (std::size_t j = m + 1; j-- > 0;) {
+        // Estimate the quotient limb from the top two limbs, then correct it at most twice
+        uint128 numerator = (static_cast<uint128>(un[j + n]) << 64) | un[j + n - 1];
+        uint128 qhat = numerator / vn[n - 1];
+        uint128 rhat = numerator % vn[n - 1];
+        while ((qhat >> 64) != 0 || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if ((rhat >> 64) != 0) {
+                break;
+            }
+        }
+
+        // Multiply and subtract
+        __int128 borrow = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            uint128 product = qhat * vn[i];
+            __int128 t = static_cast<__int128>(un[i + j]) - borrow - static_cast<uint64_t>(product);
+            un[i + j] = static_cast<uint64_t>(t);
+            borrow = static_cast<__int128>(product >> 64) - (t >> 64);
+        }
+        __int128 t = static_cast<__int128>(un[j + n]) - borrow;
+        un[j + n] = static_cast<uint64_t>(t);
+
+        // The estimate was one too large: add the divisor back
+        if (t < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (std::size_t i = 0; i < n; i++) {
+                uint128 sum = static_cast<uint128>(un[i + j]) + vn[i] + carry;
+                un[i + j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            un[j + n] += carry;
+        }
+        quotient[j] = static_cast<uint64_t>(qhat);
+    }
+    trim(quotient);
+
+    // Unnormalize the remainder
+    remainder.assign(n, 0);
+    for (std::size_t i = 0; i < n; i++) {
+        remainder[i] = shift == 0 ? un[i] : (un[i] >> shift) | (un[i + 1] << (64 - shift));
+    }
+    trim(remainder);
+}
+
+// @brief Compute gcd(a, b) of two limbs with the binary algorithm
+uint64_t gcd_small(uint64_t a, uint64_t b) {
+    if (a == 0 || b == 0) {
+        return a | b;
+    }
+    int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0) {
+        b >>= __builtin_ctzll(b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+// @brief Return bits [shift, shift + 62) of a
+int64_t bits_at(const Limbs& a, long long shift) {
+    std::size_t index = static_cast<std::size_t>(shift / 64);
+    int offset = static_cast<int>(shift % 64);
+    if (index >= a.size()) {
+        return 0;
+    }
+    uint64_t bits = a[index] >> offset;
+    if (offset != 0 && index + 1 < a.size()) {
+        bits |= a[index + 1] << (64 - offset);
+    }
+    return static_cast<int64_t>(bits & ((1ull << 62) - 1));
+}
+
+long long bit_length_of(const Limbs& a) {
+    return a.empty() ? 0 : 64 * static_cast<long long>(a.size()) - __builtin_clzll(a.back());
+}
+
+// @brief Compute x * a + y * b, where the result is known to be non-negative
+//        (the cofactors have opposite signs, or one of them is zero)
+Limbs combine(const Limbs& a, int64_t x, const Limbs& b, int64_t y) {
+    Limbs xa = mul_small(a, static_cast<uint64_t>(x < 0 ? -x : x));
+    Limbs yb = mul_small(b, static_cast<uint64_t>(y < 0 ? -y : y));
+    if (x >= 0 && y >= 0) {
+        return add_magnitude(xa, yb);
+    }
+    if (x >= 0) {
+        sub_in_place(xa, yb);
+        return xa;
+    }
+    sub_in_place(yb, xa);
+    return yb;
+}
+
+// @brief Compute gcd(a, b) with Lehmer's algorithm.
+//        While both numbers have several limbs, Euclid's algorithm is simulated on their leading
+//        62 bits, as long as the quotients are certain to be the same as for the full numbers
+//        (Knuth's Algorithm L). The collected 2x2 cofactor matrix is then applied to a and b at
+//        once, replacing many multi-limb divisions by two linear combinations.
+Limbs gcd_magnitude(Limbs a, Limbs b) {
+    if (compare_magnitude(a, b) < 0) {
+        std::swap(a, b);
+    }
+    while (b.size() > 1) {
+        long long shift = bit_length_of(a) - 62;
+        int64_t ah = bits_at(a, shift), bh = bits_at(b, shift);
+        int64_t x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+        // The divisors must stay positive, or the truncating division would not be a floor
+        while (bh + x1 > 0 && bh + y1 > 0) {
+            int64_t q = (ah + x0) / (bh + x1);
+            if (q != (ah + y0) / (bh + y1)) {
+                break;
+            }
+            int64_t t = x0 - q * x1;
+            x0 = x1, x1 = t;
+            t = y0 - q * y1;
+            y0 = y1, y1 = t;
+            t = ah - q * bh;
+            ah = bh, bh = t;
+        }
+
+        if (y0 == 0) {
+            // No step could be simulated: do one full division step
+            Limbs quotient, remainder;
+            divmod_magnitude(a, b, quotient, remainder);
+            a = std::move(b);
+            b = std::move(remainder);
+        } else {
+            Limbs next_a = combine(a, x0, b, y0);
+            Limbs next_b = combine(a, x1, b, y1);
+            a = std::move(next_a);
+            b = std::move(next_b);
+        }
+    }
+
+    if (b.empty()) {
+        return a;
+    }
+    // b has a single limb: one division brings a down to a limb too
+    uint64_t result = gcd_small(b[0], mod_small(a, b[0]));
+    return Limbs(1, result);
+}
+
+}   // namespace
+
+// Constructors
+
+BigInteger::BigInteger(): negative(false) {}
+
+BigInteger::BigInteger(long long value): negative(value < 0) {
+    uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    if (magnitude != 0) {
+        limbs.push_back(magnitude);
+    }
+}
+
+BigInteger::BigInteger(std::vector<uint64_t> limbs, bool negative): limbs(std::move(limbs)), negative(negative) {
+    trim(this->limbs);
+    if (this->limbs.empty()) {
+        this->negative = false;
+    }
+}
+
+// Arthematical operators
+
+BigInteger BigInteger::operator-() const {
+    return BigInteger(limbs, !negative);
+}
+
+BigInteger BigInteger::operator+(const BigInteger& other) const {
+    if (negative == other.negative) {
+        return BigInteger(add_magnitude(limbs, other.limbs), negative);
+    }
+    // Different signs: subtract the smaller magnitude from the larger one
+    if (compare_magnitude(limbs, other.limbs) >= 0) {
+        return BigInteger(sub_magnitude(limbs, other.limbs), negative);
+    }
+    return BigInteger(sub_magnitude(other.limbs, limbs), other.negative);
+}
+
+BigInteger BigInteger::operator-(const BigInteger& other) const {
+    return *this + (-other);
+}
+
+BigInteger BigInteger::operator*(const BigInteger& other) const {
+    // A one-limb operand (often a small integer) needs a single pass over the other one
+    if (limbs.size() == 1) {
+        return BigInteger(mul_small(other.limbs, limbs[0]), negative != other.negative);
+    }
+    if (other.limbs.size() == 1) {
+        return BigInteger(mul_small(limbs, other.limbs[0]), negative != other.negative);
+    }
+    return BigInteger(mul_magnitude(limbs, other.limbs), negative != other.negative);
+}
+
+BigInteger BigInteger::operator/(const BigInteger& other) const {
+    BigInteger quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return quotient;
+}
+
+BigInteger BigInteger::operator%(const BigInteger& other) const {
+    BigInteger quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+BigInteger BigInteger::operator<<(int bits) const {
+    if (limbs.empty()) {
+        return *this;
+    }
+    Limbs result(bits / 64, 0);
+    Limbs shifted = shift_left_bits(limbs, bits % 64);
+    result.insert(result.end(), shifted.begin(), shifted.end());
+    return BigInteger(std::move(result), negative);
+}
+
+// @brief Shift the magnitude right, so that the result truncates toward zero like operator/
+BigInteger BigInteger::operator>>(int bits) const {
+    std::size_t skip = static_cast<std::size_t>(bits / 64);
+    if (skip >= limbs.size()) {
+        return BigInteger();
+    }
+    int offset = bits % 64;
+    Limbs result(limbs.size() - skip);
+    for (std::size_t i = 0; i < result.size(); i++) {
+        result[i] = limbs[i + skip] >> offset;
+        if (offset != 0 && i + skip + 1 < limbs.size()) {
+            result[i] |= limbs[i + skip + 1] << (64 - offset);
+        }
+    }
+    return BigInteger(std::move(result), negative);
+}
+
+// @brief Compute the quotient and the remainder at once. If b is zero, throw an exception.
+void BigInteger::divmod(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder) {
+    if (b.is_zero()) {
+        throw "Division by zero";
+    }
+    Limbs q, r;
+    divmod_magnitude(a.limbs, b.limbs, q, r);
+    quotient = BigInteger(std::move(q), a.negative != b.negative);
+    remainder = BigInteger(std::move(r), a.negative);
+}
+
+BigInteger BigInteger::gcd(const BigInteger& a, const BigInteger& b) {
+    return BigInteger(gcd_magnitude(a.limbs, b.limbs), false);
+}
+
+// Comparison operators
+
+int BigInteger::compare(const BigInteger& other) const {
+    if (negative != other.negative) {
+        return negative ? -1 : 1;
+    }
+    int result = compare_magnitude(limbs, other.limbs);
+    return negative ? -result : result;
+}
+
+bool BigInteger::operator==(const BigInteger& other) const {
+    return negative == other.negative && limbs == other.limbs;
+}
+
+bool BigInteger::operator!=(const BigInteger& other) const {
+    return !(*this == other);
+}
+
+bool BigInteger::operator<(const BigInteger& other) const {
+    return compare(other) < 0;
+}
+
+bool BigInteger::operator<=(const BigInteger& other) const {
+    return compare(other) <= 0;
+}
+
+bool BigInteger::operator>(const BigInteger& other) const {
+    return compare(other) > 0;
+}
+
+bool BigInteger::operator>=(const BigInteger& other) const {
+    return compare(other) >= 0;
+}
+
+int BigInteger::sign() const {
+    return limbs.empty() ? 0 : (negative ? -1 : 1);
+}
+
+bool BigInteger::is_zero() const {
+    return limbs.empty();
+}
+
+BigInteger BigInteger::abs() const {
+    return BigInteger(limbs, false);
+}
+
+int BigInteger::size() const {
+    return static_cast<int>(limbs.size());
+}
+
+long long BigInteger::bit_length() const {
+    return bit_length_of(limbs);
+}
+
+// @brief Convert BigInteger to a double (infinity if it is out of range)
+double BigInteger::to_double() const {
+    double result = 0;
+    for (std::size_t i = limbs.size(); i-- > 0;) {
+        result = result * 18446744073709551616.0 + static_cast<double>(limbs[i]);
+    }
+    return negative ? -result : result;
+}
+
+// @brief Convert BigInteger to a decimal string, 19 digits per division
+std::string BigInteger::to_string() const {
+    if (limbs.empty()) {
+        return "0";
+    }
+    Limbs rest = limbs;
+    std::vector<uint64_t> chunks;
+    while (!rest.empty()) {
+        chunks.push_back(divmod_small(rest, DECIMAL_BASE));
+    }
+
+    std::string result = negative ? "-" : "";
+    result += std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        result.append(DECIMAL_DIGITS - chunk.size(), '0');
+        result += chunk;
+    }
+    return result;
+}
+
+// @brief Convert a decimal string to BigInteger, 19 digits per multiplication.
+//        Leading whitespace and a sign are accepted, and parsing stops at the first non-digit.
+//        If there is no digit, throw std::invalid_argument.
+void BigInteger::from_string(const std::string& str) {
+    std::size_t pos = 0;
+    while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos]))) {
+        pos++;
+    }
+    bool is_negative = false;
+    if (pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+        is_negative = str[pos] == '-';
+        pos++;
+    }
+    std::size_t end = pos;
+    while (end < str.size() && std::isdigit(static_cast<unsigned char>(str[end]))) {
+        end++;
+    }
+    if (end == pos) {
+        throw std::invalid_argument("BigInteger::from_string");
+    }
+
+    Limbs result;
+    while (pos < end) {
+        std::size_t count = std::min<std::size_t>(DECIMAL_DIGITS, end - pos);
+        uint64_t chunk = 0, scale = 1;
+        for (std::size_t i = 0; i < count; i++, pos++) {
+            chunk = chunk * 10 + static_cast<uint64_t>(str[pos] - '0');
+            scale *= 10;
+        }
+        if (result.empty()) {
+            if (chunk != 0) {
+                result.push_back(chunk);
+            }
+        } else {
+            mul_add_small(result, scale, chunk);
+        }
+    }
+    *this = BigInteger(std::move(result), is_negative);
+}
+
+// Overload the << and >> operators for output and input
+std::ostream& operator<<(std::ostream& os, const BigInteger& x) {
+    os << x.to_string();
+    return os;
+}
+
+std::istream& operator>>(std::istream& is, BigInteger& x) {
+    std::string str;
+    if (is >> str) {
+        x.from_string(str);
+    }
+    return is;
+}
@@ -1,299 +1,570 @@
 #include "fraction.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
 // Helper functions
+namespace {
 
-// @brief Compute the greatest common divisor of a and b using Euclid's algorithm
-int gcd(int a, int b) {
-    // if b is zero, return a
-    // otherwise, continue computing the gcd of b and a % b
-    return b == 0 ? a : gcd(b, a % b);
-}
+using fraction_detail::gcd;
+using fraction_detail::magnitude;
 
-// @brief Compute the least common multiple of a and b
-int lcm(int a, int b) {
-    // lcm(a, b) = a * b / gcd(a, b)
-    return a * b / gcd(a, b);
+inline bool is_digit(char c) {
+    return c >= '0' && c <= '9';
 }
 
-// @brief Compute a^exp
-int pow(int base, int exp) {
-    int result = 1;
-    for (int i = 0; i < exp; i++) {
-        result *= base;
+// @brief Append a digit to the mantissa of a number. Zeros are counted in zeros and only
+//        multiplied in before the next nonzero digit, so that trailing zeros ("1.50000") never
+//        overflow; leading zeros are dropped. Return false if it overflows.
+template<class T>
+inline bool append_digit(T& mantissa, long long& zeros, int digit) {
+    if (digit == 0) {
+        zeros += mantissa != 0;
+        return true;
+    }
+    for (; zeros > 0; zeros--) {
+        if (__builtin_mul_overflow(mantissa, 10, &mantissa)) {
+            return false;
+        }
     }
-    return result;
+    return !__builtin_mul_overflow(mantissa, 10, &mantissa) &&
+           !__builtin_add_overflow(mantissa, static_cast<T>(digit), &mantissa);
 }
 
-// @brief Compute sgn(x)
-inline int sgn(int x) {
-    if (x > 0) {
-        return 1;
-    } else if (x < 0) {
-        return -1;
+// @brief Append the run of digits at p to the mantissa, and return where it ends.
+//        digits counts the digits appended so far: while the mantissa cannot have more digits
+//        than T always holds, the run is appended without checking each digit for overflow.
+template<class T>
+const char* append_digits(const char* p, const char* last, T& mantissa, long long& zeros, long long& digits,
+                          bool& overflow) {
+    const int safe_digits = sizeof(T) == 8 ? 19 : 38;
+    const char* end = p;
+    while (end != last && is_digit(*end)) {
+        end++;
+    }
+    if (zeros == 0 && digits + (end - p) <= safe_digits) {
+        digits += end - p;
+        for (; p != end; p++) {
+            mantissa = mantissa * 10 + static_cast<T>(*p - '0');
+        }
     } else {
-        return 0;
+        digits = safe_digits + 1;
+        for (; p != end; p++) {
+            overflow |= !append_digit(mantissa, zeros, *p - '0');
+        }
     }
+    return end;
 }
 
-// @brief Compute |x|
-inline int abs(int x) {
-    return x >= 0 ? x : -x;
-}
-
-// @brief Get the number of digits of integer x
-int get_digit_num(int x) {
-    int digit_num = 0;
-    while (x > 0) {
-        x /= 10;
-        digit_num++;
+// @brief Compute x * 10^exp, return false if it overflows
+template<class T>
+bool scale_by_power_of_ten(T& x, long long exp) {
+    for (; exp > 0; exp--) {
+        if (__builtin_mul_overflow(x, 10, &x)) {
+            return false;
+        }
     }
-    return digit_num;
+    return true;
 }
 
-// @brief Reduce the fraction to lowest terms
-void Fraction::reduce() {
-    if (denominator == 0) {
-        throw "Denominator cannot be zero";
+// Two decimal digits for every number below 100, to format a number two digits at a time
+const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// @brief Write the decimal digits of x, which is not negative, backwards so that they end
+//        before end, and return where they begin
+inline char* format_digits(char* end, uint64_t x) {
+    while (x >= 100) {
+        unsigned pair = static_cast<unsigned>(x % 100) * 2;
+        x /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
     }
-
-    // Get the greatest common divisor of numerator and denominator
-    int gcd_val = gcd(numerator, denominator);
-
-    // Divide numerator and denominator by gcd_val
-    numerator /= gcd_val;
-    denominator /= gcd_val;
-}
-
-// Constructors
-
-// Default constructor: Set fraction to 0
-Fraction::Fraction(): numerator(0), denominator(1), sign(0) {}
-
-// Constructor with numerator and denominator
-// If denominator is zero, throw an exception
-// Automatically set the sign of the fraction and reduce it to lowest terms
-Fraction::Fraction(int numerator, int denominator) {
-    if (denominator == 0) {
-        throw "Denominator cannot be zero";
+    if (x >= 10) {
+        *--end = digit_pairs[x * 2 + 1];
+        *--end = digit_pairs[x * 2];
+    } else {
+        *--end = static_cast<char>('0' + x);
     }
-    this->sign = sgn(numerator) * sgn(denominator);
-    this->numerator = abs(numerator);
-    this->denominator = abs(denominator);
-    reduce();
+    return end;
 }
 
-// Constructor with numerator, denominator, and sign
-// If denominator is zero, throw an exception
-// Assume numerator and denominator are both positive
-// Automatically reduce the fraction to lowest terms
-Fraction::Fraction(int numerator, int denominator, int sign) {
-    if (denominator == 0) {
-        throw "Denominator cannot be zero";
+// @brief A wider number is written 19 digits at a time, so that most divisions are in 64 bits
+inline char* format_digits(char* end, unsigned __int128 x) {
+    const uint64_t chunk = 10000000000000000000ull;
+    while (x > UINT64_MAX) {
+        uint64_t low = static_cast<uint64_t>(x % chunk);
+        x /= chunk;
+        char* begin = format_digits(end, low);
+        while (end - begin < 19) {
+            *--begin = '0';
+        }
+        end = begin;
     }
-    this->numerator = abs(numerator);
-    this->denominator = abs(denominator);
-    this->sign = sign;
-    reduce();
-}
-
-Fraction::Fraction(const Fraction& other) {
-    numerator = other.numerator;
-    denominator = other.denominator;
-    sign = other.sign;
-    reduce();
+    return format_digits(end, static_cast<uint64_t>(x));
 }
 
-// Arthematical operators
-Fraction Fraction::operator+(const Fraction& other) const {
-    // reduce the two fractions to a common denominator
-    int new_denominator = lcm(denominator, other.denominator);
-    int new_numerator = sign * numerator * (new_denominator / denominator) + other.sign * other.numerator * (new_denominator / other.denominator);
-    
-    // The constructor will solve the sign and reduce the fraction automatically
-    return Fraction(new_numerator, new_denominator);
+// @brief Count the decimal digits of x: estimate them from the bit length, then correct
+//        the estimate with a power of ten
+inline int count_digits(uint64_t x) {
+    static const uint64_t powers_of_ten[] = {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+        1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+        1000000000000000000ull, 10000000000000000000ull};
+    // log10(2) is about 1233 / 4096, so this is the number of digits of 2^bits, or one more
+    int estimate = (64 - __builtin_clzll(x | 1)) * 1233 >> 12;
+    return estimate + 1 - ((x | 1) < powers_of_ten[estimate]);
 }
 
-Fraction Fraction::operator-(const Fraction& other) const {
-    // reduce the two fractions to a common denominator
-    int new_denominator = lcm(denominator, other.denominator);
-    int new_numerator = sign * numerator * (new_denominator / denominator) - other.sign * other.numerator * (new_denominator / other.denominator);
-
-    // The constructor will solve the sign and reduce the fraction automatically
-    return Fraction(new_numerator, new_denominator);
+inline int count_digits(unsigned __int128 x) {
+    const uint64_t chunk = 10000000000000000000ull;
+    int digits = 0;
+    while (x > UINT64_MAX) {
+        x /= chunk;
+        digits += 19;
+    }
+    return digits + count_digits(static_cast<uint64_t>(x));
 }
 
-Fraction Fraction::operator*(const Fraction& other) const {
-    return Fraction(numerator * other.numerator, denominator * other.denominator, sign * other.sign);
+// @brief Split a finite double into |x| = mantissa * 2^exponent with an odd mantissa, or a
+//        zero mantissa for zero
+inline uint64_t decompose(double x, int& exponent) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    int biased = static_cast<int>(bits >> 52 & 0x7ff);
+    uint64_t mantissa = bits & ((1ull << 52) - 1);
+    if (biased == 0) {
+        exponent = -1074;   // subnormal
+    } else {
+        mantissa |= 1ull << 52;
+        exponent = biased - 1075;
+    }
+    if (mantissa != 0) {
+        int zeros = fraction_detail::ctz(mantissa);
+        mantissa >>= zeros;
+        exponent += zeros;
+    }
+    return mantissa;
 }
 
-Fraction Fraction::operator/(const Fraction& other) const {
-    return Fraction(numerator * other.denominator, denominator * other.numerator, sign * other.sign);
+// @brief The number of significant bits of x
+inline int bit_length(uint64_t x) {
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
 }
 
-// Comparison operators
-bool Fraction::operator==(const Fraction& other) const {
-    // Since the fractions are reduced, we only need to compare the signs, numerator, and denominator
-    return sign == other.sign && numerator == other.numerator && denominator == other.denominator;
+// @brief Move the convergents h0/k0, h1/k1 of a continued fraction on by its next term a.
+//        Return false, leaving them unchanged, if the next convergent is out of bounds.
+template<class W, class A>
+inline bool next_convergent(A a, W max_num, W max_den, W& h0, W& h1, W& k0, W& k1) {
+    W h2 = 0, k2 = 0;
+    if (a > static_cast<W>(-1) ||
+        __builtin_mul_overflow(static_cast<W>(a), k1, &k2) || __builtin_add_overflow(k2, k0, &k2) || k2 > max_den ||
+        __builtin_mul_overflow(static_cast<W>(a), h1, &h2) || __builtin_add_overflow(h2, h0, &h2) || h2 > max_num) {
+        return false;
+    }
+    h0 = h1;
+    h1 = h2;
+    k0 = k1;
+    k1 = k2;
+    return true;
 }
 
-bool Fraction::operator!=(const Fraction& other) const {
-    return !(*this == other);
+// @brief The closest fraction to x between the last convergent h1/k1 and the semiconvergents
+//        (t * h1 + h0) / (t * k1 + k0) in bounds, once the next convergent is out of bounds,
+//        where p and q are the last two remainders. Return false if there is no convergent
+//        yet: the integer part of x is out of bounds.
+template<class W, class R>
+inline bool closest_semiconvergent(R p, R q, W max_num, W max_den, W h0, W h1, W k0, W k1, W& num, W& den) {
+    if (k1 == 0) {
+        return false;
+    }
+    W t = (max_den - k0) / k1;
+    if (h1 != 0 && (max_num - h0) / h1 < t) {
+        t = (max_num - h0) / h1;
+    }
+    // t is below the next term, so t * q < p. The error of h1/k1 is q / (Q * k1), and that of
+    // the semiconvergent with t is (p - t * q) / (Q * ks), with Q the denominator of x.
+    W hs = t * h1 + h0, ks = t * k1 + k0;
+    int order;
+    if constexpr (sizeof(R) <= 8 && sizeof(W) <= 8) {
+        unsigned __int128 error_s = static_cast<unsigned __int128>(p - t * q) * k1;
+        unsigned __int128 error_c = static_cast<unsigned __int128>(q) * ks;
+        order = (error_s > error_c) - (error_s < error_c);
+    } else {
+        order = fraction_detail::compare_products(p - t * q, k1, q, ks);
+    }
+    if (order < 0) {
+        num = hs;
+        den = ks;
+    } else {
+        num = h1;
+        den = k1;
+    }
+    return true;
 }
 
-bool Fraction::operator<(const Fraction& other) const {
-    // To compare two fractions, we first need to compare their signs
-    if (sign < other.sign) {
-        return true;
-    } else if (sign > other.sign) {
-        return false;
-    } else {  // If their signs are equal, compare their absolute values
-        if (sign == 0) return false;  // If both fractions are zero, they are equal
-
-        // reduce the two fractions to a common denominator
-        int lcm_val = lcm(denominator, other.denominator);
-        int new_numerator1 = numerator * (lcm_val / denominator);
-        int new_numerator2 = other.numerator * (lcm_val / other.denominator);
-        
-        if (sign == 1) {  // If both fractions are positive, the fraction with smaller absolute value is smaller
-            return new_numerator1 < new_numerator2;
-        } else {  // If both fractions are negative, the fraction with larger absolute value is smaller
-            return new_numerator1 > new_numerator2;
+// @brief The closest fraction num/den to x = p/q with num <= max_num and den <= max_den, from
+//        the continued fraction of x. Its convergents are computed until the next one is out
+//        of bounds; the answer is then the last convergent or the semiconvergent after it
+//        closest to x. With s_n the remainders of Euclid's algorithm on p and q, the error of
+//        a convergent is a remainder over its denominator and q, so the candidates are
+//        compared without any division. num and den are coprime.
+//        Return false if the integer part of x is greater than max_num.
+template<class W>
+bool best_approximation(unsigned __int128 p, unsigned __int128 q, W max_num, W max_den, W& num, W& den) {
+    W h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+    // Only the first two steps may need 128-bit remainders: q is then below the mantissa
+    while ((p >> 64) != 0 || (q >> 64) != 0) {
+        unsigned __int128 a = p / q, r = p - a * q;
+        if (!next_convergent(a, max_num, max_den, h0, h1, k0, k1)) {
+            return closest_semiconvergent(p, q, max_num, max_den, h0, h1, k0, k1, num, den);
         }
+        if (r == 0) {
+            num = h1;
+            den = k1;
+            return true;
+        }
+        p = q;
+        q = r;
+    }
+    uint64_t p64 = static_cast<uint64_t>(p), q64 = static_cast<uint64_t>(q);
+    while (true) {
+        uint64_t a = p64 / q64, r = p64 - a * q64;
+        if (!next_convergent(a, max_num, max_den, h0, h1, k0, k1)) {
+            return closest_semiconvergent(p64, q64, max_num, max_den, h0, h1, k0, k1, num, den);
+        }
+        if (r == 0) {
+            num = h1;
+            den = k1;
+            return true;
+        }
+        p64 = q64;
+        q64 = r;
     }
 }
 
-bool Fraction::operator<=(const Fraction& other) const {
-    return *this == other || *this < other;
-}
+}   // namespace
 
-bool Fraction::operator>(const Fraction& other) const {
-    return !(*this <= other);
+// @brief Convert Fraction to a string (fraction)
+template<class Int>
+std::string BasicFraction<Int>::to_string() const {
+    char buf[max_chars];
+    std::to_chars_result result = to_chars(buf, buf + max_chars, *this);
+    return std::string(buf, result.ptr);
 }
 
-bool Fraction::operator>=(const Fraction& other) const {
-    return !(*this < other);
+// @brief Convert a string (fraction or decimal) to Fraction
+template<class Int>
+void BasicFraction<Int>::from_string(std::string_view str) {
+    std::size_t pos = 0;
+    while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos]))) {
+        pos++;
+    }
+    BasicFraction<Int> value;
+    std::from_chars_result result = from_chars(str.data() + pos, str.data() + str.size(), value);
+    if (result.ec == std::errc::invalid_argument) {
+        throw std::invalid_argument("from_string: not a fraction, an integer or a decimal");
+    } else if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("from_string: out of range for the integer type");
+    } else if (result.ec == std::errc::argument_out_of_domain) {
+        throw "Denominator cannot be zero";
+    }
+    *this = value;
 }
 
-// @brief Convert Fraction to a double
-double Fraction::to_double() const {
-    return static_cast<double>(numerator) / denominator * sign;
+// @brief Convert a string (decimal) to Fraction: from_string reads decimals too
+template<class Int>
+void BasicFraction<Int>::from_decimal_string(std::string_view str) {
+    from_string(str);
 }
 
-// @brief Convert Fraction to a string (fraction)
-std::string Fraction::to_string() const {
-    std::string result = "";
-    if (sign == 0) {    // If the fraction is zero, we only need to output "0"
-        result += "0";
+// @brief x = mantissa * 2^exponent with an odd mantissa: the fraction is mantissa * 2^exponent
+//        if exponent >= 0, and mantissa / 2^-exponent in lowest terms otherwise
+template<class Int>
+void BasicFraction<Int>::from_double(double x) {
+    if (std::isnan(x)) {
+        throw std::invalid_argument("from_double: not finite (NaN)");
+    }
+    if (std::isinf(x)) {
+        throw std::out_of_range("from_double: not finite (infinity)");
+    }
+    // max = 2^bits - 1
+    const int bits = 8 * sizeof(Int) - 1;
+    int exponent = 0;
+    uint64_t mantissa = decompose(x, exponent);
+    if (mantissa == 0) {
+        *this = BasicFraction<Int>();
+    } else if (exponent >= 0) {
+        if (bit_length(mantissa) + exponent > bits) {
+            throw std::out_of_range("from_double: out of range for the integer type");
+        }
+        *this = from_reduced(static_cast<UInt>(mantissa) << exponent, 1, x < 0);
     } else {
-        if (sign == -1) {  // If the fraction is negative, output "-" before the numerator
-            result += "-";
+        if (bit_length(mantissa) > bits) {
+            throw std::out_of_range("from_double: the exact numerator is out of range for the integer type");
         }
-
-        // Output the numerator
-        result += std::to_string(numerator);
-
-        // If the denominator is 1, the denominator will be omitted
-        if (denominator != 1) {
-            result += "/" + std::to_string(denominator);
+        if (-exponent > bits - 1) {
+            throw std::out_of_range("from_double: the exact denominator is out of range for the integer type");
         }
+        *this = from_reduced(static_cast<UInt>(mantissa), static_cast<UInt>(1) << -exponent, x < 0);
     }
-    return result;
 }
 
-// @brief Convert a string (fraction) to Fraction
-void Fraction::from_string(const std::string& str) {
-    std::string buf = str;
-
-    // If a minus sing is found, the fraction is negative
-    int minus_pos = buf.find('-');
-    if (minus_pos != std::string::npos) {
-        sign = -1;
-        buf.erase(0, minus_pos + 1);  // Erase the minus sign
-    } else {
-        sign = 1;
+// @brief A double below 2^-126 in magnitude is first rounded to a multiple of 2^-126, so that the
+//        continued fraction runs on 128-bit integers; that only changes the result if
+//        max_denominator is at least 2^73, which needs a 128-bit Int
+template<class Int>
+void BasicFraction<Int>::from_double(double x, UInt max_denominator) {
+    if (max_denominator == 0) {
+        throw std::invalid_argument("from_double: the maximum denominator must be positive");
+    }
+    if (std::isnan(x)) {
+        throw std::invalid_argument("from_double: not finite (NaN)");
+    }
+    if (std::isinf(x)) {
+        throw std::out_of_range("from_double: not finite (infinity)");
+    }
+    int exponent = 0;
+    uint64_t mantissa = decompose(x, exponent);
+    if (exponent >= 0 || mantissa == 0) {
+        // An integer needs no approximation
+        from_double(x);
+        return;
+    }
+    if (exponent < -126) {
+        int shift = -126 - exponent;
+        mantissa = shift > 64 ? 0 : ((mantissa >> (shift - 1)) + 1) >> 1;
+        exponent = -126;
+        if (mantissa == 0) {
+            *this = BasicFraction<Int>();
+            return;
+        }
     }
 
-    // Find the slash position
-    int slash_pos = buf.find('/');
-    if (slash_pos == std::string::npos) {
-        // If no slash is found, the fraction is an integer
-        // We can set the denominator to 1 and set the numerator to the integer value
-        numerator = std::stoi(buf);
-        denominator = 1;
-    } else {
-        // If a slash is found, parse the numerator and denominator respectively
-        numerator = std::stoi(buf.substr(0, slash_pos));
-        denominator = std::stoi(buf.substr(slash_pos + 1));
+    // The convergents are computed in 64 bits for up to 64-bit fractions
+    typedef std::conditional_t<sizeof(Int) <= 8, uint64_t, unsigned __int128> W;
+    W max_den = max_denominator < static_cast<UInt>(traits::max) ? max_denominator : static_cast<UInt>(traits::max);
+    W num = 0, den = 1;
+    if (!best_approximation<W>(mantissa, static_cast<unsigned __int128>(1) << -exponent,
+                               static_cast<W>(traits::max), max_den, num, den)) {
+        throw std::out_of_range("from_double: the integer part is out of range for the integer type");
     }
+    *this = from_reduced(static_cast<UInt>(num), static_cast<UInt>(den), x < 0);
+}
 
-    // If the numerator is zero, we need to set the sign to 0
-    if (numerator == 0) {
-        sign = 0;
+// @brief Parse a fraction in a single pass over the characters.
+//        "a/b" is reduced with a gcd, taken in twice the width if a part does not fit in Int.
+//        A decimal is read as mantissa * 10^exponent: with a negative exponent, the
+//        denominator 2^k * 5^k is reduced by cancelling the factors 2 and 5 of the mantissa,
+//        so no gcd is needed.
+template<class Int>
+std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<Int>& value) {
+    typedef typename fraction_detail::int_traits<Int>::unsigned_type UInt;
+    // The mantissa of a decimal is read in twice the width (up to 128 bits), so that one with
+    // more digits than Int holds still fits when its factors 2 and 5 cancel
+    typedef std::conditional_t<sizeof(Int) == 4, uint64_t, unsigned __int128> Mantissa;
+    const UInt max = static_cast<UInt>(fraction_detail::int_traits<Int>::max);
+
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    p += negative;
+    Mantissa mantissa = 0;
+    long long zeros = 0, exponent = 0;
+    bool overflow = false;
+
+    const char* integer_begin = p;
+    long long digits = 0;
+    p = append_digits(p, last, mantissa, zeros, digits, overflow);
+    bool has_integer = p != integer_begin;
+
+    // "a/b", if a digit follows the slash
+    if (has_integer && p != last && *p == '/' && p + 1 != last && is_digit(p[1])) {
+        Mantissa denominator = 0;
+        long long denominator_zeros = 0, denominator_digits = 0;
+        p = append_digits(p + 1, last, denominator, denominator_zeros, denominator_digits, overflow);
+        overflow |= !scale_by_power_of_ten(mantissa, zeros) || !scale_by_power_of_ten(denominator, denominator_zeros);
+        if (overflow) {
+            return {p, std::errc::result_out_of_range};
+        }
+        if (denominator == 0) {
+            return {p, std::errc::argument_out_of_domain};
+        }
+        if (mantissa > max || denominator > max) {
+            // The parts may still fit once reduced, so the gcd is taken in the wide type, whose
+            // gcd needs both below its signed max
+            const Mantissa wide_max = static_cast<Mantissa>(-1) >> 1;
+            if (mantissa > wide_max || denominator > wide_max) {
+                return {p, std::errc::result_out_of_range};
+            }
+            Mantissa wide_gcd = gcd(mantissa, denominator);
+            mantissa /= wide_gcd;
+            denominator /= wide_gcd;
+            if (mantissa > max || denominator > max) {
+                return {p, std::errc::result_out_of_range};
+            }
+            value = BasicFraction<Int>::from_reduced(static_cast<UInt>(mantissa), static_cast<UInt>(denominator), negative);
+            return {p, std::errc()};
+        }
+        UInt numerator = static_cast<UInt>(mantissa), d = static_cast<UInt>(denominator);
+        UInt gcd_val = gcd(numerator, d);
+        value = BasicFraction<Int>::from_reduced(numerator / gcd_val, d / gcd_val, negative);
+        return {p, std::errc()};
     }
 
-    // Reduce the fraction to lowest terms
-    reduce();
-}
+    // The fractional part, if there are digits before or after the dot
+    if (p != last && *p == '.') {
+        const char* q = append_digits(p + 1, last, mantissa, zeros, digits, overflow);
+        exponent -= q - (p + 1);
+        if (has_integer || q != p + 1) {
+            p = q;
+        }
+    }
+    if (p == integer_begin) {
+        return {first, std::errc::invalid_argument};
+    }
 
-// @brief Convert a string (decimal) to Fraction
-void Fraction::from_decimal_string(const std::string& str) {
-    std::string buf = str;
+    // The exponent, if a digit follows the "e" and its sign. It saturates, as any exponent
+    // that large overflows a nonzero mantissa.
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool exponent_negative = q != last && *q == '-';
+        q += q != last && (*q == '+' || *q == '-');
+        if (q != last && is_digit(*q)) {
+            long long e = 0;
+            for (; q != last && is_digit(*q); q++) {
+                e = e < 1000000 ? e * 10 + (*q - '0') : e;
+            }
+            exponent += exponent_negative ? -e : e;
+            p = q;
+        }
+    }
 
-    // If a minus sing is found, the fraction is negative
-    int minus_pos = buf.find('-');
-    if (minus_pos != std::string::npos) {
-        sign = -1;
-        buf.erase(0, minus_pos + 1);  // Erase the minus sign
+    if (overflow) {
+        return {p, std::errc::result_out_of_range};
+    }
+    if (mantissa == 0) {
+        value = BasicFraction<Int>();
+        return {p, std::errc()};
+    }
+    exponent += zeros;
+    Mantissa denominator = 1;
+    if (exponent >= 0) {
+        if (!scale_by_power_of_ten(mantissa, exponent)) {
+            return {p, std::errc::result_out_of_range};
+        }
     } else {
-        sign = 1;
+        long long twos = -exponent, fives = -exponent;
+        long long shift = std::min<long long>(fraction_detail::ctz(mantissa), twos);
+        mantissa >>= shift;
+        twos -= shift;
+        for (; fives > 0 && mantissa % 5 == 0; fives--) {
+            mantissa /= 5;
+        }
+        if (twos >= static_cast<long long>(sizeof(Mantissa) * 8)) {
+            return {p, std::errc::result_out_of_range};
+        }
+        denominator <<= twos;
+        for (; fives > 0; fives--) {
+            if (__builtin_mul_overflow(denominator, 5, &denominator)) {
+                return {p, std::errc::result_out_of_range};
+            }
+        }
+    }
+    if (mantissa > max || denominator > max) {
+        return {p, std::errc::result_out_of_range};
     }
+    value = BasicFraction<Int>::from_reduced(static_cast<UInt>(mantissa), static_cast<UInt>(denominator), negative);
+    return {p, std::errc()};
+}
 
-    // Find the dot position
-    int dot_pos = buf.find('.');
-    if (dot_pos == std::string::npos) {
-        // If no dot is found, the fraction is an integer
-        // We can set the denominator to 1 and set the numerator to the integer value
-        numerator = std::stoi(buf);
-        denominator = 1;
-    } else {
-        // If a dot is found, parse the integer and decimal parts respectively
-        int integer_part = (dot_pos == 0) ? 0 : std::stoi(buf.substr(0, dot_pos));
-        int decimal_part = std::stoi(buf.substr(dot_pos + 1));
+// @brief The length is counted first, then the parts are formatted backwards in place
+template<class Int>
+std::to_chars_result to_chars(char* first, char* last, const BasicFraction<Int>& value) {
+    typedef std::conditional_t<sizeof(Int) <= 8, uint64_t, unsigned __int128> Digits;
+    Digits numerator = static_cast<Digits>(magnitude(value.get_numerator()));
+    Digits denominator = static_cast<Digits>(value.get_denominator());
+    bool negative = value.get_numerator() < 0;
+    // If the denominator is 1, the denominator will be omitted
+    std::size_t length = negative + count_digits(numerator) + (denominator != 1 ? 1 + count_digits(denominator) : 0);
+    if (static_cast<std::size_t>(last - first) < length) {
+        return {last, std::errc::value_too_large};
+    }
 
-        // We can set Fraction = integer_part * 10^n + decimal_part
-        // where n is the number of digits in the decimal part
-        int decimal_digit_num = get_digit_num(decimal_part);
-        numerator = integer_part * pow(10, decimal_digit_num) + decimal_part;
-        denominator = pow(10, decimal_digit_num);
+    char* end = first + length;
+    char* p = end;
+    if (denominator != 1) {
+        p = format_digits(p, denominator);
+        *--p = '/';
     }
+    // Output the numerator, "0" if the fraction is zero
+    format_digits(p, numerator);
+    if (negative) {  // If the fraction is negative, output "-" before the numerator
+        *first = '-';
+    }
+    return {end, std::errc()};
+}
 
-    // If the numerator is zero, we need to set the sign to 0
-    if (numerator == 0) {
-        sign = 0;
+template<class Int>
+void from_doubles(const double* first, const double* last, BasicFraction<Int>* out) {
+    for (; first != last; first++, out++) {
+        out->from_double(*first);
     }
+}
 
-    // Reduce the fraction to lowest terms
-    reduce();
+template<class Int>
+void from_doubles(const double* first, const double* last, BasicFraction<Int>* out,
+                  typename fraction_detail::int_traits<Int>::unsigned_type max_denominator) {
+    for (; first != last; first++, out++) {
+        out->from_double(*first, max_denominator);
+    }
 }
 
 // Overload the << and >> operators for output and input
-std::ostream& operator<<(std::ostream& os, const Fraction& f) {
-    os << f.to_string();
+template<class Int>
+std::ostream& operator<<(std::ostream& os, const BasicFraction<Int>& f) {
+    char buf[BasicFraction<Int>::max_chars];
+    std::to_chars_result result = to_chars(buf, buf + sizeof(buf), f);
+    os << std::string_view(buf, result.ptr - buf);
     return os;
 }
 
-std::istream& operator>>(std::istream& is, Fraction& f) {
+// A fraction or a decimal, up to the next whitespace; the stream is left unchanged at its end
+template<class Int>
+std::istream& operator>>(std::istream& is, BasicFraction<Int>& f) {
     std::string str;
-    is >> str;
-    
-    // Try to parse the string as a fraction first, then as a decimal
-    if (str.find('/') != std::string::npos) {
+    if (is >> str) {
         f.from_string(str);
-    } else {
-        f.from_decimal_string(str);
     }
     return is;
 }
 
+// Explicit instantiations for the supported integer types
+template class BasicFraction<int32_t>;
+template class BasicFraction<int64_t>;
+template class BasicFraction<__int128>;
+
+template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<int32_t>& value);
+template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<int64_t>& value);
+template std::from_chars_result from_chars(const char* first, const char* last, BasicFraction<__int128>& value);
+template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<int32_t>& value);
+template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<int64_t>& value);
+template std::to_chars_result to_chars(char* first, char* last, const BasicFraction<__int128>& value);
+template void from_doubles(const double* first, const double* last, BasicFraction<int32_t>* out);
+template void from_doubles(const double* first, const double* last, BasicFraction<int64_t>* out);
+template void from_doubles(const double* first, const double* last, BasicFraction<__int128>* out);
+template void from_doubles(const double* first, const double* last, BasicFraction<int32_t>* out, uint32_t max_denominator);
+template void from_doubles(const double* first, const double* last, BasicFraction<int64_t>* out, uint64_t max_denominator);
+template void from_doubles(const double* first, const double* last, BasicFraction<__int128>* out, unsigned __int128 max_denominator);
+template std::istream& operator>>(std::istream& is, BasicFraction<int32_t>& f);
+template std::istream& operator>>(std::istream& is, BasicFraction<int64_t>& f);
+template std::istream& operator>>(std::istream& is, BasicFraction<__int128>& f);
+template std::ostream& operator<<(std::ostream& os, const BasicFraction<int32_t>& f);
+template std::ostream& operator<<(std::ostream& os, const BasicFraction<int64_t>& f);
+template std::ostream& operator<<(std::ostream& os, const BasicFraction<__int128>& f);
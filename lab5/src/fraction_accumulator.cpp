@@ -0,0 +1,142 @@
+#include "fraction_accumulator.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+FractionAccumulator::FractionAccumulator() {
+    clear();
+}
+
+void FractionAccumulator::clear() {
+    numerator = 0;
+    denominator = 1;
+    std::memset(quotients, 0, sizeof(quotients));
+}
+
+// @brief With l = lcm(D, b) = D * (b / g) where g = gcd(D, b), N/D + a/b = (N * (b / g) + a * (D / g)) / l.
+//        The result is not reduced: D stays the lcm of every denominator added so far.
+void FractionAccumulator::add_slow(__int128 a, uint64_t b) {
+    while (true) {
+        uint64_t g = fraction_detail::gcd(denominator, b);
+        uint64_t scale = b / g, quotient = denominator / g;
+        uint64_t new_denominator;
+        __int128 scaled, term, sum;
+        if (!__builtin_mul_overflow(denominator, scale, &new_denominator) && new_denominator <= max_denominator &&
+            !__builtin_mul_overflow(numerator, static_cast<__int128>(scale), &scaled) &&
+            !__builtin_mul_overflow(a, static_cast<__int128>(quotient), &term) &&
+            !__builtin_add_overflow(scaled, term, &sum)) {
+            if (scale != 1) {
+                denominator = new_denominator;
+                std::memset(quotients, 0, sizeof(quotients));
+            } else if (b < cached_denominators) {
+                quotients[b] = quotient;
+            }
+            numerator = sum;
+            return;
+        }
+        if (!normalize()) {
+            break;
+        }
+    }
+    // An intermediate overflows even in lowest terms, but the reduced sum may still fit:
+    // Fraction128 adds with both gcds and reduces the result
+    Fraction128 result = sum() + Fraction128(a, static_cast<__int128>(b));
+    if (result.get_denominator() > max_denominator) {
+        throw "Fraction overflow";
+    }
+    numerator = result.get_numerator();
+    denominator = static_cast<uint64_t>(result.get_denominator());
+    std::memset(quotients, 0, sizeof(quotients));
+}
+
+// @brief gcd(N, D) = gcd(N mod D, D), a gcd of two 64-bit values
+bool FractionAccumulator::normalize() {
+    unsigned __int128 n = numerator >= 0 ? static_cast<unsigned __int128>(numerator)
+                                         : 0 - static_cast<unsigned __int128>(numerator);
+    uint64_t g = fraction_detail::gcd(static_cast<uint64_t>(n % denominator), denominator);
+    if (g == 1) {
+        return false;
+    }
+    numerator /= static_cast<__int128>(g);
+    denominator /= g;
+    std::memset(quotients, 0, sizeof(quotients));
+    return true;
+}
+
+// @brief The common case: the denominator is small and divides the running one, so the
+//        numerator is scaled by the cached quotient and added. |a| < 2^31 and the quotient
+//        is below 2^64, so only the addition can overflow.
+void FractionAccumulator::add(int32_t a, uint32_t b) {
+    if (b < cached_denominators && quotients[b] != 0) {
+        __int128 sum;
+        if (!__builtin_add_overflow(numerator, static_cast<__int128>(a) * quotients[b], &sum)) {
+            numerator = sum;
+            return;
+        }
+    }
+    add_slow(a, b);
+}
+
+void FractionAccumulator::add(const Fraction& value) {
+    add(value.numerator, value.denominator);
+}
+
+void FractionAccumulator::add(const Fraction64& value) {
+    add_slow(value.numerator, value.denominator);
+}
+
+FractionAccumulator& FractionAccumulator::operator+=(const Fraction& value) {
+    add(value);
+    return *this;
+}
+
+FractionAccumulator& FractionAccumulator::operator+=(const Fraction64& value) {
+    add(value);
+    return *this;
+}
+
+// @brief other is reduced first, so that it only overflows if the reduced sum does
+void FractionAccumulator::merge(const FractionAccumulator& other) {
+    FractionAccumulator part = other;
+    part.normalize();
+    add_slow(part.numerator, part.denominator);
+}
+
+Fraction128 FractionAccumulator::sum() const {
+    return Fraction128(numerator, static_cast<__int128>(denominator));
+}
+
+Fraction128 FractionAccumulator::parallel_sum(const std::vector<Fraction>& values, unsigned threads) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    std::vector<FractionAccumulator> parts(threads);
+    // An exception in a thread is rethrown here, after every thread has finished
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    std::size_t chunk = (values.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::size_t begin = std::min(values.size(), t * chunk), end = std::min(values.size(), begin + chunk);
+            try {
+                for (std::size_t i = begin; i < end; i++) {
+                    parts[t].add(values[i]);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    FractionAccumulator result;
+    for (unsigned t = 0; t < threads; t++) {
+        if (errors[t]) {
+            std::rethrow_exception(errors[t]);
+        }
+        result.merge(parts[t]);
+    }
+    return result.sum();
+}
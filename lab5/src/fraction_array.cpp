@@ -0,0 +1,355 @@
+#include "fraction_array.h"
+#include "fraction_accumulator.h"
+#include <cstring>
+
+// Helper functions
+namespace {
+
+const uint32_t max_part = 0x7fffffff;   // the largest numerator magnitude and denominator
+
+// Vectors of 16 lanes (GCC vector extensions). They are lowered to AVX-512, AVX2 or plain
+// scalar code, depending on the clone of gcd_batch() that runs.
+const int lanes = 16;
+typedef uint32_t lanes_u32 __attribute__((vector_size(4 * lanes)));
+typedef int32_t lanes_i32 __attribute__((vector_size(4 * lanes)));
+typedef float lanes_f32 __attribute__((vector_size(4 * lanes)));
+typedef double lanes_f64 __attribute__((vector_size(8 * lanes)));
+
+// The number of elements per block of an element-wise operation, so that its temporary
+// columns stay in the L1 cache
+const std::size_t block_size = 1024;
+
+// The helpers below take and return vectors by reference: the clones of gcd_batch() pass vectors
+// by value in different registers, and without optimizations the helpers are not inlined into them
+
+// @brief Count the trailing zero bits of each lane (none may be zero) from the exponent of its
+//        lowest set bit, converted to float: there is no vector instruction for it before AVX-512
+inline void lanes_ctz(const lanes_u32& x, lanes_u32& result) {
+    lanes_u32 lowest = x & -x;
+    lanes_f32 power = __builtin_convertvector((lanes_i32)lowest, lanes_f32);
+    lanes_i32 exponent = ((lanes_i32)power >> 23) & 0xff;
+    result = (lanes_u32)exponent - 127;
+}
+
+// @brief Whether any lane of a comparison result is set
+inline bool lanes_any(const lanes_u32& mask) {
+    uint64_t words[lanes / 2];
+    std::memcpy(words, &mask, sizeof(mask));
+    uint64_t any = 0;
+    for (uint64_t word : words) {
+        any |= word;
+    }
+    return any != 0;
+}
+
+// @brief out[i] = gcd(a[i], b[i]) for all i < n, with every value at most max_part.
+//        It is the binary gcd of fraction.cpp, run on a block of 16 pairs at a time with every
+//        branch turned into a lane-wise select; a block finishes when its slowest pair does.
+//        The tail is padded with ones.
+__attribute__((target_clones("avx512f", "avx2", "default")))
+void gcd_batch(const uint32_t* a, const uint32_t* b, uint32_t* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; i += lanes) {
+        std::size_t count = n - i < static_cast<std::size_t>(lanes) ? n - i : lanes;
+        lanes_u32 u = {}, v = {}, zero = {}, one = zero + 1;
+        if (count == static_cast<std::size_t>(lanes)) {
+            std::memcpy(&u, a + i, sizeof(u));
+            std::memcpy(&v, b + i, sizeof(v));
+        } else {
+            u = v = one;
+            std::memcpy(&u, a + i, count * sizeof(uint32_t));
+            std::memcpy(&v, b + i, count * sizeof(uint32_t));
+        }
+
+        // gcd(0, v) = v, and gcd(0, 0) = 0 is computed as gcd(1, 1) and fixed at the end
+        u = u == 0 ? v : u;
+        v = v == 0 ? u : v;
+        lanes_u32 both_zero = u == 0;
+        u = both_zero ? one : u;
+        v = both_zero ? one : v;
+
+        lanes_u32 shift, u_zeros, v_zeros;
+        lanes_ctz(u | v, shift);
+        lanes_ctz(u, u_zeros);
+        lanes_ctz(v, v_zeros);
+        u >>= u_zeros;
+        v >>= v_zeros;
+        // u and v are odd; a lane is done when they are equal
+        lanes_u32 unequal = u != v;
+        while (lanes_any(unequal)) {
+            lanes_i32 diff = (lanes_i32)u - (lanes_i32)v;
+            v = u < v ? u : v;
+            lanes_i32 abs_diff = diff < 0 ? -diff : diff;
+            lanes_u32 d = (lanes_u32)abs_diff, d_zeros;
+            unequal = d != 0;
+            lanes_ctz(unequal ? d : one, d_zeros);
+            u = unequal ? d >> d_zeros : v;
+        }
+
+        lanes_u32 result = both_zero ? zero : v << shift;
+        std::memcpy(out + i, &result, count * sizeof(uint32_t));
+    }
+}
+
+// @brief out[i] = x[i] / g[i] for all i < n, where g[i] divides x[i] and every value is at most
+//        max_part. The quotient is computed in double precision, which is exact for a quotient
+//        of integers below 2^53 that divide evenly, and double division is vectorized.
+__attribute__((target_clones("avx512f", "avx2", "default")))
+void divide_batch(const uint32_t* x, const uint32_t* g, uint32_t* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        lanes_u32 u, v;
+        std::memcpy(&u, x + i, sizeof(u));
+        std::memcpy(&v, g + i, sizeof(v));
+        lanes_f64 quotient = __builtin_convertvector((lanes_i32)u, lanes_f64) / __builtin_convertvector((lanes_i32)v, lanes_f64);
+        lanes_i32 result = __builtin_convertvector(quotient, lanes_i32);
+        std::memcpy(out + i, &result, sizeof(result));
+    }
+    for (; i < n; i++) {
+        out[i] = x[i] / g[i];
+    }
+}
+
+// @brief |x| as an unsigned number
+inline uint32_t magnitude(int32_t x) {
+    return x >= 0 ? static_cast<uint32_t>(x) : 0u - static_cast<uint32_t>(x);
+}
+
+// @brief Cross-reduce and multiply a block of at most block_size elements:
+//        with g1 = gcd(p, s) and g2 = gcd(q, r), the result is (p / g1) * (q / g2) over
+//        (r / g2) * (s / g1), in lowest terms. a/b * c/d is p = |a|, q = |c|, r = b, s = d,
+//        and a/b / c/d is p = |a|, q = d, r = b, s = |c|.
+//        The results are stored only if none of them overflows; return whether one does.
+bool multiply_block(const uint32_t* p, const uint32_t* q, const uint32_t* r, const uint32_t* s,
+                    const bool* negative, int32_t* numerators, uint32_t* denominators, std::size_t count) {
+    uint32_t gcd1[block_size], gcd2[block_size], p1[block_size], q1[block_size], r1[block_size], s1[block_size];
+    gcd_batch(p, s, gcd1, count);
+    gcd_batch(q, r, gcd2, count);
+    divide_batch(p, gcd1, p1, count);
+    divide_batch(s, gcd1, s1, count);
+    divide_batch(q, gcd2, q1, count);
+    divide_batch(r, gcd2, r1, count);
+
+    int32_t new_numerators[block_size];
+    uint32_t new_denominators[block_size];
+    bool overflow = false;
+    for (std::size_t i = 0; i < count; i++) {
+        uint64_t numerator = static_cast<uint64_t>(p1[i]) * q1[i];
+        uint64_t denominator = static_cast<uint64_t>(r1[i]) * s1[i];
+        // A zero operand leaves a zero numerator over a denominator that is not 1
+        denominator = numerator == 0 ? 1 : denominator;
+        overflow |= (numerator | denominator) > max_part;
+        new_numerators[i] = negative[i] ? -static_cast<int32_t>(numerator) : static_cast<int32_t>(numerator);
+        new_denominators[i] = static_cast<uint32_t>(denominator);
+    }
+    if (overflow) {
+        return true;
+    }
+    std::memcpy(numerators, new_numerators, count * sizeof(int32_t));
+    std::memcpy(denominators, new_denominators, count * sizeof(uint32_t));
+    return false;
+}
+
+}   // namespace
+
+// @brief Throw an exception if other does not have the same size
+void FractionArray::check_size(const FractionArray& other) const {
+    if (size() != other.size()) {
+        throw "Size mismatch";
+    }
+}
+
+// Constructors
+
+// Default constructor: an empty array
+FractionArray::FractionArray() {}
+
+FractionArray::FractionArray(std::size_t size): numerators(size, 0), denominators(size, 1) {}
+
+FractionArray::FractionArray(const std::vector<Fraction>& values) {
+    numerators.reserve(values.size());
+    denominators.reserve(values.size());
+    for (const Fraction& value : values) {
+        push_back(value);
+    }
+}
+
+std::size_t FractionArray::size() const {
+    return numerators.size();
+}
+
+Fraction FractionArray::get(std::size_t index) const {
+    Fraction result;
+    result.numerator = numerators[index];
+    result.denominator = denominators[index];
+    return result;
+}
+
+void FractionArray::set(std::size_t index, const Fraction& value) {
+    numerators[index] = value.numerator;
+    denominators[index] = value.denominator;
+}
+
+void FractionArray::push_back(const Fraction& value) {
+    numerators.push_back(value.numerator);
+    denominators.push_back(value.denominator);
+}
+
+std::vector<Fraction> FractionArray::to_vector() const {
+    std::vector<Fraction> result(size());
+    for (std::size_t i = 0; i < size(); i++) {
+        result[i] = get(i);
+    }
+    return result;
+}
+
+// Arthematical operators
+
+FractionArray FractionArray::operator+(const FractionArray& other) const {
+    FractionArray result = *this;
+    return result += other;
+}
+
+FractionArray FractionArray::operator-(const FractionArray& other) const {
+    FractionArray result = *this;
+    return result -= other;
+}
+
+FractionArray FractionArray::operator*(const FractionArray& other) const {
+    FractionArray result = *this;
+    return result *= other;
+}
+
+FractionArray FractionArray::operator/(const FractionArray& other) const {
+    FractionArray result = *this;
+    return result /= other;
+}
+
+// @brief a/b + c/d element-wise (Knuth, 4.5.1), or a/b - c/d if subtract is set:
+//        with g = gcd(b, d) and t = a * (d / g) + c * (b / g), the result is
+//        (t / g2) / ((b / g) * (d / g2)) where g2 = gcd(t, g) = gcd(t mod g, g).
+//        Both gcds are of 32-bit values, so each one is a single batch per block.
+FractionArray& FractionArray::add(const FractionArray& other, bool subtract) {
+    check_size(other);
+    int64_t other_sign = subtract ? -1 : 1;
+    bool overflow = false;
+    for (std::size_t start = 0; start < size() && !overflow; start += block_size) {
+        std::size_t count = size() - start < block_size ? size() - start : block_size;
+        int32_t* a = numerators.data() + start;
+        uint32_t* b = denominators.data() + start;
+        const int32_t* c = other.numerators.data() + start;
+        const uint32_t* d = other.denominators.data() + start;
+
+        uint32_t gcd1[block_size], b1[block_size], d1[block_size], remainder[block_size], gcd2[block_size];
+        int64_t sum[block_size];
+        gcd_batch(b, d, gcd1, count);
+        divide_batch(b, gcd1, b1, count);
+        divide_batch(d, gcd1, d1, count);
+        for (std::size_t i = 0; i < count; i++) {
+            sum[i] = static_cast<int64_t>(a[i]) * d1[i] + other_sign * c[i] * b1[i];
+            // Most denominators are coprime, and then g2 = 1
+            uint64_t t = sum[i] >= 0 ? static_cast<uint64_t>(sum[i]) : 0 - static_cast<uint64_t>(sum[i]);
+            remainder[i] = gcd1[i] == 1 ? 0 : static_cast<uint32_t>(t % gcd1[i]);
+        }
+        gcd_batch(remainder, gcd1, gcd2, count);
+
+        int32_t new_numerators[block_size];
+        uint32_t new_denominators[block_size];
+        for (std::size_t i = 0; i < count; i++) {
+            int64_t numerator = gcd2[i] == 1 ? sum[i] : sum[i] / static_cast<int64_t>(gcd2[i]);
+            uint64_t denominator = static_cast<uint64_t>(b1[i]) * (gcd2[i] == 1 ? d[i] : d[i] / gcd2[i]);
+            denominator = numerator == 0 ? 1 : denominator;
+            overflow |= numerator > static_cast<int64_t>(max_part) || numerator < -static_cast<int64_t>(max_part) ||
+                        denominator > max_part;
+            new_numerators[i] = static_cast<int32_t>(numerator);
+            new_denominators[i] = static_cast<uint32_t>(denominator);
+        }
+        // The results of a block are stored only if none of them overflows
+        if (!overflow) {
+            std::memcpy(a, new_numerators, count * sizeof(int32_t));
+            std::memcpy(b, new_denominators, count * sizeof(uint32_t));
+        }
+    }
+    if (overflow) {
+        throw "Fraction overflow";
+    }
+    return *this;
+}
+
+FractionArray& FractionArray::operator+=(const FractionArray& other) {
+    return add(other, false);
+}
+
+FractionArray& FractionArray::operator-=(const FractionArray& other) {
+    return add(other, true);
+}
+
+// @brief a/b * c/d element-wise, cross-reducing first with g1 = gcd(a, d) and g2 = gcd(c, b),
+//        like Fraction does; the gcds of a block are two batches
+FractionArray& FractionArray::operator*=(const FractionArray& other) {
+    check_size(other);
+    bool overflow = false;
+    for (std::size_t start = 0; start < size() && !overflow; start += block_size) {
+        std::size_t count = size() - start < block_size ? size() - start : block_size;
+        uint32_t a[block_size], c[block_size];
+        bool negative[block_size];
+        for (std::size_t i = 0; i < count; i++) {
+            a[i] = magnitude(numerators[start + i]);
+            c[i] = magnitude(other.numerators[start + i]);
+            negative[i] = (numerators[start + i] < 0) != (other.numerators[start + i] < 0);
+        }
+        overflow = multiply_block(a, c, denominators.data() + start, other.denominators.data() + start, negative,
+                                  numerators.data() + start, denominators.data() + start, count);
+    }
+    if (overflow) {
+        throw "Fraction overflow";
+    }
+    return *this;
+}
+
+// @brief a/b / c/d = a/b * d/c element-wise, cross-reduced the same way
+FractionArray& FractionArray::operator/=(const FractionArray& other) {
+    check_size(other);
+    for (int32_t numerator : other.numerators) {
+        if (numerator == 0) {
+            throw "Denominator cannot be zero";
+        }
+    }
+    bool overflow = false;
+    for (std::size_t start = 0; start < size() && !overflow; start += block_size) {
+        std::size_t count = size() - start < block_size ? size() - start : block_size;
+        uint32_t a[block_size], c[block_size];
+        bool negative[block_size];
+        for (std::size_t i = 0; i < count; i++) {
+            a[i] = magnitude(numerators[start + i]);
+            c[i] = magnitude(other.numerators[start + i]);
+            negative[i] = (numerators[start + i] < 0) != (other.numerators[start + i] < 0);
+        }
+        overflow = multiply_block(a, other.denominators.data() + start, denominators.data() + start, c, negative,
+                                  numerators.data() + start, denominators.data() + start, count);
+    }
+    if (overflow) {
+        throw "Fraction overflow";
+    }
+    return *this;
+}
+
+Fraction128 FractionArray::sum() const {
+    FractionAccumulator result;
+    for (std::size_t i = 0; i < size(); i++) {
+        result.add(numerators[i], denominators[i]);
+    }
+    return result.sum();
+}
+
+// @brief a/b compared with c/d element-wise: the denominators are positive, so it is the sign
+//        of a * d - c * b, which fits in 64 bits
+std::vector<int> FractionArray::compare(const FractionArray& other) const {
+    check_size(other);
+    std::vector<int> result(size());
+    for (std::size_t i = 0; i < size(); i++) {
+        int64_t product1 = static_cast<int64_t>(numerators[i]) * other.denominators[i];
+        int64_t product2 = static_cast<int64_t>(other.numerators[i]) * denominators[i];
+        result[i] = (product1 > product2) - (product1 < product2);
+    }
+    return result;
+}
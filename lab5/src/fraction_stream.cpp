@@ -0,0 +1,347 @@
+// fraction_stream: evaluate a large file of fractions, one per line, in constant memory.
+//
+// Each line is a value ("3/4", "-2", "1.05", "2.5e-3") or an expression of two values
+// ("1/2 + 3/4", "1/2 / 3/4", "0.5 * 2e3"), and the result is written on the same line of the
+// output, in lowest terms, or "error: <message>" if it cannot be computed. An empty line stays
+// empty.
+//
+// The input is read in chunks of whole lines into a ring of buffers. Worker threads parse the
+// lines in place with from_chars and format the results with to_chars into the output buffer of
+// the same chunk, and a writer thread writes the chunks out in order. The ring holds two chunks
+// per worker, so memory does not grow with the input.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fraction.h"
+
+// Helper functions
+namespace {
+
+struct Options {
+    unsigned workers = 1;
+    std::size_t chunk_size = 1 << 20;   // bytes read per chunk
+    int bits = 64;                      // the width of the fractions
+    bool quiet = false;                 // do not report the rate
+    std::string input = "-", output = "-";
+};
+
+// A block of whole lines and the results of evaluating them
+struct Chunk {
+    enum State { FREE, READ, DONE };
+    State state = FREE;
+    std::vector<char> input, output;
+    std::size_t input_size = 0, output_size = 0, lines = 0;
+};
+
+void usage() {
+    std::cerr << "Usage: fraction_stream [-j workers] [-c chunk_kib] [-w 32|64|128] [-q] [input [output]]\n"
+                 "Evaluate one fraction or expression (a op b, op in + - * /) per line.\n"
+                 "input and output default to - (standard input and output).\n";
+}
+
+// @brief Parse the command line, return false if it is invalid
+bool parse_options(int argc, char **argv, Options& options) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "-c" || arg == "-w") && i + 1 < argc) {
+            long value = std::strtol(argv[++i], nullptr, 10);
+            if (value <= 0) {
+                return false;
+            }
+            if (arg == "-j") {
+                options.workers = static_cast<unsigned>(value);
+            } else if (arg == "-c") {
+                options.chunk_size = static_cast<std::size_t>(value) << 10;
+            } else if (value == 32 || value == 64 || value == 128) {
+                options.bits = static_cast<int>(value);
+            } else {
+                return false;
+            }
+        } else if (arg == "-q") {
+            options.quiet = true;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            return false;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.size() > 2) {
+        return false;
+    }
+    if (files.size() > 0) {
+        options.input = files[0];
+    }
+    if (files.size() > 1) {
+        options.output = files[1];
+    }
+    return true;
+}
+
+inline const char* skip_blanks(const char* p, const char* end) {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+    return p;
+}
+
+// @brief Append s to out
+inline char* append(char* out, const char* s) {
+    std::size_t length = std::strlen(s);
+    std::memcpy(out, s, length);
+    return out + length;
+}
+
+// @brief Parse a value at p, skipping the blanks before it. Return nullptr with the message in
+//        error if there is none.
+template<class Int>
+const char* parse_value(const char* p, const char* end, BasicFraction<Int>& value, const char*& error) {
+    std::from_chars_result result = from_chars(skip_blanks(p, end), end, value);
+    if (result.ec == std::errc::invalid_argument) {
+        error = "invalid number";
+    } else if (result.ec == std::errc::result_out_of_range) {
+        error = "number out of range";
+    } else if (result.ec == std::errc::argument_out_of_domain) {
+        error = "Denominator cannot be zero";
+    } else {
+        return result.ptr;
+    }
+    return nullptr;
+}
+
+// @brief Evaluate the line [p, end) and write the result to out, which has room for it.
+//        Return the end of the result.
+template<class Int>
+char* evaluate_line(const char* p, const char* end, char* out) {
+    const char* error = nullptr;
+    BasicFraction<Int> x, y, result;
+    if (skip_blanks(p, end) == end) {
+        return out;
+    }
+    p = parse_value(p, end, x, error);
+    if (p != nullptr) {
+        p = skip_blanks(p, end);
+        if (p == end) {
+            result = x;
+        } else {
+            char op = *p;
+            if (op != '+' && op != '-' && op != '*' && op != '/') {
+                error = "invalid expression";
+            } else if ((p = parse_value(p + 1, end, y, error)) == nullptr) {
+                // error is set
+            } else if (skip_blanks(p, end) != end) {
+                error = "invalid expression";
+            } else {
+                try {
+                    switch (op) {
+                        case '+': result = x + y; break;
+                        case '-': result = x - y; break;
+                        case '*': result = x * y; break;
+                        case '/': result = x / y; break;
+                    }
+                } catch (const char* msg) {
+                    error = msg;
+                }
+            }
+        }
+    }
+    if (error != nullptr) {
+        return append(append(out, "error: "), error);
+    }
+    return to_chars(out, out + BasicFraction<Int>::max_chars, result).ptr;
+}
+
+// The longest result of a line: a fraction or an error message, and the newline
+template<class Int>
+constexpr std::size_t max_result_size = BasicFraction<Int>::max_chars + 64;
+
+// @brief Evaluate every line of the chunk into its output buffer
+template<class Int>
+void evaluate_chunk(Chunk& chunk) {
+    const char* p = chunk.input.data();
+    const char* end = p + chunk.input_size;
+    chunk.lines = 0;
+    chunk.output_size = 0;
+    while (p != end) {
+        const char* line_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+        if (chunk.output.size() - chunk.output_size < max_result_size<Int>) {
+            chunk.output.resize(chunk.output.size() * 2 + max_result_size<Int>);
+        }
+        char* out = evaluate_line<Int>(p, line_end, chunk.output.data() + chunk.output_size);
+        *out++ = '\n';
+        chunk.output_size = out - chunk.output.data();
+        chunk.lines++;
+        p = line_end == end ? end : line_end + 1;
+    }
+}
+
+// @brief Read the next chunk of whole lines from in, after the partial line carried over from
+//        the previous chunk, and carry the partial line at its end over to the next one. A line
+//        longer than the chunk size grows the chunk. Return false at the end of the input, or
+//        at a read error, which the caller finds with ferror(in).
+bool read_chunk(std::FILE* in, std::size_t chunk_size, std::vector<char>& carry, Chunk& chunk) {
+    if (chunk.input.size() < carry.size() + chunk_size) {
+        chunk.input.resize(carry.size() + chunk_size);
+    }
+    std::memcpy(chunk.input.data(), carry.data(), carry.size());
+    std::size_t size = carry.size();
+    carry.clear();
+    while (true) {
+        std::size_t count = std::fread(chunk.input.data() + size, 1, chunk.input.size() - size, in);
+        size += count;
+        if (count == 0) {
+            // The end of the input: the last line needs no newline
+            chunk.input_size = size;
+            return size > 0;
+        }
+        const char* begin = chunk.input.data();
+        std::size_t whole = size;
+        while (whole > 0 && begin[whole - 1] != '\n') {
+            whole--;
+        }
+        if (whole > 0) {
+            carry.assign(begin + whole, begin + size);
+            chunk.input_size = whole;
+            return true;
+        }
+        if (size == chunk.input.size()) {
+            chunk.input.resize(chunk.input.size() * 2);
+        }
+    }
+}
+
+// @brief Stream the input through the workers to the output, return the number of lines
+template<class Int>
+std::size_t run(const Options& options, std::FILE* in, std::FILE* out) {
+    std::vector<Chunk> ring(2 * options.workers);
+    std::mutex mutex;
+    std::condition_variable changed;
+    // Chunks are numbered in input order; chunk i lives in ring[i % ring.size()]
+    std::size_t read_count = 0, taken_count = 0;
+    bool end_of_input = false;
+    std::size_t lines = 0;
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < options.workers; t++) {
+        workers.emplace_back([&]() {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return taken_count < read_count || end_of_input; });
+                if (taken_count == read_count) {
+                    return;
+                }
+                Chunk& chunk = ring[taken_count++ % ring.size()];
+                lock.unlock();
+                evaluate_chunk<Int>(chunk);
+                lock.lock();
+                chunk.state = Chunk::DONE;
+                changed.notify_all();
+            }
+        });
+    }
+
+    std::thread writer([&]() {
+        for (std::size_t written = 0; ; written++) {
+            std::unique_lock<std::mutex> lock(mutex);
+            Chunk& chunk = ring[written % ring.size()];
+            changed.wait(lock, [&]() { return written < read_count ? chunk.state == Chunk::DONE : end_of_input; });
+            if (written == read_count) {
+                return;
+            }
+            lock.unlock();
+            std::fwrite(chunk.output.data(), 1, chunk.output_size, out);
+            lines += chunk.lines;
+            lock.lock();
+            chunk.state = Chunk::FREE;
+            changed.notify_all();
+        }
+    });
+
+    // The reader runs on this thread
+    std::vector<char> carry;
+    while (true) {
+        Chunk& chunk = ring[read_count % ring.size()];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return chunk.state == Chunk::FREE; });
+        }
+        bool more = read_chunk(in, options.chunk_size, carry, chunk);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!more) {
+            end_of_input = true;
+            changed.notify_all();
+            break;
+        }
+        chunk.state = Chunk::READ;
+        read_count++;
+        changed.notify_all();
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    writer.join();
+    return lines;
+}
+
+}   // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+    std::FILE* in = options.input == "-" ? stdin : std::fopen(options.input.c_str(), "rb");
+    if (in == nullptr) {
+        std::perror(options.input.c_str());
+        return 1;
+    }
+    std::FILE* out = options.output == "-" ? stdout : std::fopen(options.output.c_str(), "wb");
+    if (out == nullptr) {
+        std::perror(options.output.c_str());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t lines = options.bits == 32 ? run<int32_t>(options, in, out)
+                      : options.bits == 64 ? run<int64_t>(options, in, out)
+                      : run<__int128>(options, in, out);
+    std::fflush(out);
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    // A read error ends the input early, so the output would look complete
+    bool failed = false;
+    if (std::ferror(in)) {
+        std::cerr << options.input << ": read error, the output is incomplete" << std::endl;
+        failed = true;
+    }
+    if (std::ferror(out)) {
+        std::cerr << options.output << ": write error, the output is incomplete" << std::endl;
+        failed = true;
+    }
+
+    if (!options.quiet) {
+        std::cerr << lines << " lines in " << seconds.count() << " s, " << lines / seconds.count()
+                  << " lines/s (" << options.workers << " workers)" << std::endl;
+    }
+    if (in != stdin) {
+        std::fclose(in);
+    }
+    if (out != stdout && std::fclose(out) != 0 && !failed) {
+        std::perror(options.output.c_str());
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
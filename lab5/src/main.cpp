@@ -1,12 +1,17 @@
 #include <iostream>
 #include "fraction.h"
+#include "big_fraction.h"
+#include "fraction_accumulator.h"
+#include "fraction_array.h"
+#include "rational_matrix.h"
 
 // Test functions
 
 // @brief Output the result of arithmetical operations of two fractions.
 // @param f1 The first operand.
 // @param f2 The second operand.
-void test_arithmetical_operations(Fraction f1, Fraction f2) {
+template<class F>
+void test_arithmetical_operations(F f1, F f2) {
     std::cout << f1 << " + " << f2 << " = " << f1 + f2 << std::endl;
     std::cout << f1 << " - " << f2 << " = " << f1 - f2 << std::endl;
     std::cout << f1 << " * " << f2 << " = " << f1 * f2 << std::endl;
@@ -16,7 +21,8 @@ void test_arithmetical_operations(Fraction f1, Fraction f2) {
 // @brief Output the result of relational operations of two fractions.
 // @param f1 The first operand.
 // @param f2 The second operand.
-void test_relational_operations(Fraction f1, Fraction f2) {
+template<class F>
+void test_relational_operations(F f1, F f2) {
     std::cout << f1 << " == " << f2 << " : " << (f1 == f2) << std::endl;
     std::cout << f1 << "!= " << f2 << " : " << (f1!= f2) << std::endl;
     std::cout << f1 << " < " << f2 << " : " << (f1 < f2) << std::endl;
@@ -52,6 +58,133 @@ void test_conversion_from_string(std::string str) {
     std::cout << str << " to Fraction = " << f << std::endl;
 }
 
+// @brief Output the result of one operation, or the error it throws.
+template<class F>
+void print_checked(const std::string& expr, F op) {
+    try {
+        auto result = op();
+        std::cout << expr << " = " << result << std::endl;
+    } catch (const char* msg) {
+        std::cout << expr << " : " << msg << std::endl;
+    }
+}
+
+// @brief Test for operations on fractions of the given integer type whose intermediate results may overflow.
+template<class Int>
+void test_wide_operations() {
+    BasicFraction<Int> f1, f2;
+    std::cin >> f1 >> f2;
+    std::string prefix = f1.to_string() + " ";
+    std::string suffix = " " + f2.to_string();
+    print_checked(prefix + "+" + suffix, [&]() { return f1 + f2; });
+    print_checked(prefix + "-" + suffix, [&]() { return f1 - f2; });
+    print_checked(prefix + "*" + suffix, [&]() { return f1 * f2; });
+    print_checked(prefix + "/" + suffix, [&]() { return f1 / f2; });
+    print_checked(prefix + "<" + suffix, [&]() { return f1 < f2; });
+}
+
+// @brief Format the elements of an array of fractions or of comparison results, separated by spaces.
+template<class T>
+std::string join(const std::vector<T>& values) {
+    std::string result;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        result += (i > 0 ? " " : "") + std::to_string(values[i]);
+    }
+    return result;
+}
+
+std::string join(const std::vector<Fraction>& values) {
+    std::string result;
+    for (std::size_t i = 0; i < values.size(); i++) {
+        result += (i > 0 ? " " : "") + values[i].to_string();
+    }
+    return result;
+}
+
+// @brief Test for element-wise operations on two arrays of fractions of the same size.
+void test_array_operations() {
+    std::size_t size;
+    std::cin >> size;
+    std::vector<Fraction> v1(size), v2(size);
+    for (Fraction& f : v1) {
+        std::cin >> f;
+    }
+    for (Fraction& f : v2) {
+        std::cin >> f;
+    }
+    FractionArray a1(v1), a2(v2);
+    std::cout << "a = " << join(v1) << std::endl;
+    std::cout << "b = " << join(v2) << std::endl;
+    print_checked("a + b", [&]() { return join((a1 + a2).to_vector()); });
+    print_checked("a - b", [&]() { return join((a1 - a2).to_vector()); });
+    print_checked("a * b", [&]() { return join((a1 * a2).to_vector()); });
+    print_checked("a / b", [&]() { return join((a1 / a2).to_vector()); });
+    print_checked("compare(a, b)", [&]() { return join(a1.compare(a2)); });
+    print_checked("sum(a)", [&]() { return a1.sum(); });
+    // The sums of a and b accumulated separately, then merged
+    print_checked("sum(a) + sum(b)", [&]() {
+        FractionAccumulator s1, s2;
+        for (const Fraction& f : v1) {
+            s1 += f;
+        }
+        for (const Fraction& f : v2) {
+            s2 += f;
+        }
+        s1.merge(s2);
+        return s1.sum();
+    });
+}
+
+// @brief Test for the elimination methods of a matrix of fractions.
+void test_matrix_operations() {
+    std::size_t rows, cols;
+    std::cin >> rows >> cols;
+    std::vector<std::vector<Fraction>> values(rows, std::vector<Fraction>(cols));
+    for (std::vector<Fraction>& row : values) {
+        for (Fraction& f : row) {
+            std::cin >> f;
+        }
+    }
+    RationalMatrix m(values);
+    std::cout << "A = " << m << std::endl;
+    print_checked("rank(A)", [&]() { return m.rank(); });
+    print_checked("rref(A)", [&]() { return m.row_echelon(); });
+    print_checked("det(A)", [&]() { return m.determinant(); });
+    print_checked("inverse(A)", [&]() { return m.inverse(); });
+    print_checked("A * inverse(A)", [&]() { return m * m.inverse(); });
+}
+
+// @brief Test for converting a double to a fraction, exactly and with a maximum denominator.
+void test_conversion_from_double() {
+    std::string str;
+    uint32_t max_denominator;
+    std::cin >> str >> max_denominator;
+    double d = std::stod(str);
+    auto print = [&](const std::string& expr, auto convert) {
+        try {
+            auto result = convert();
+            std::cout << expr << " = " << result << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << expr << " : " << e.what() << std::endl;
+        } catch (const char* msg) {
+            std::cout << expr << " : " << msg << std::endl;
+        }
+    };
+    print(str + " to Fraction", [&]() { Fraction f; f.from_double(d); return f; });
+    print(str + " to Fraction64", [&]() { Fraction64 f; f.from_double(d); return f; });
+    print(str + " with max denominator " + std::to_string(max_denominator),
+          [&]() { Fraction f; f.from_double(d, max_denominator); return f; });
+}
+
+// @brief Test for the constructor that takes the sign separately from the numerator and denominator.
+void test_signed_constructor() {
+    int numerator, denominator, sign;
+    std::cin >> numerator >> denominator >> sign;
+    std::string expr = "Fraction(" + std::to_string(numerator) + ", " + std::to_string(denominator) + ", "
+                       + std::to_string(sign) + ")";
+    print_checked(expr, [&]() { return Fraction(numerator, denominator, sign); });
+}
+
 // Test type enum, used to select test cases.
 enum TestType {
     TEST_ARITHMETICAL_OPERATIONS,
@@ -59,7 +192,13 @@ enum TestType {
     TEST_INPUT_FROM_STREAM,
     TEST_OUTPUT_TO_STREAM,
     TEST_CONVERSION,
-    TEST_CONVERSION_FROM_STRING
+    TEST_CONVERSION_FROM_STRING,
+    TEST_WIDE_OPERATIONS,
+    TEST_BIG_OPERATIONS,
+    TEST_ARRAY_OPERATIONS,
+    TEST_MATRIX_OPERATIONS,
+    TEST_CONVERSION_FROM_DOUBLE,
+    TEST_SIGNED_CONSTRUCTOR
 };
 
 int main() {
@@ -73,8 +212,14 @@ int main() {
     // 3: Test output to stream
     // 4: Test conversion
     // 5: Test conversion from string
+    // 6: Test operations on 32-, 64- or 128-bit fractions (followed by the bit width)
+    // 7: Test arithmetical and relational operations of BigFraction
+    // 8: Test element-wise operations of FractionArray (followed by the size, then both arrays)
+    // 9: Test elimination of a RationalMatrix (followed by the numbers of rows and columns, then the entries)
+    // 10: Test conversion from double (followed by the double and the maximum denominator)
+    // 11: Test the constructor with a separate sign (followed by the numerator, denominator and sign)
     // other: Exit
-    while (std::cin >> select && select >= 0 && select <= 5) {
+    while (std::cin >> select && select >= 0 && select <= 11) {
         std::cout << "[\033[1;32mTest #" << count << " for type " << select << "\033[0m]" << std::endl;
         switch (select) {
             case TEST_ARITHMETICAL_OPERATIONS: {
@@ -110,6 +255,41 @@ int main() {
                 test_conversion_from_string(str);
                 break;
             }
+            case TEST_WIDE_OPERATIONS: {
+                int bits;
+                std::cin >> bits;
+                if (bits == 32) {
+                    test_wide_operations<int32_t>();
+                } else if (bits == 64) {
+                    test_wide_operations<int64_t>();
+                } else {
+                    test_wide_operations<__int128>();
+                }
+                break;
+            }
+            case TEST_BIG_OPERATIONS: {
+                BigFraction b1, b2;
+                std::cin >> b1 >> b2;
+                test_arithmetical_operations(b1, b2);
+                test_relational_operations(b1, b2);
+                break;
+            }
+            case TEST_ARRAY_OPERATIONS: {
+                test_array_operations();
+                break;
+            }
+            case TEST_MATRIX_OPERATIONS: {
+                test_matrix_operations();
+                break;
+            }
+            case TEST_CONVERSION_FROM_DOUBLE: {
+                test_conversion_from_double();
+                break;
+            }
+            case TEST_SIGNED_CONSTRUCTOR: {
+                test_signed_constructor();
+                break;
+            }
             default: break;
         }
     }
@@ -0,0 +1,306 @@
+#include "rational_matrix.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+// Helper functions
+namespace {
+
+typedef std::vector<std::vector<BigInteger>> IntegerRows;
+
+// A step that updates fewer entries than this runs on one thread
+const std::size_t parallel_entries = 4096;
+
+// The outcome of an elimination
+struct Elimination {
+    std::size_t rank = 0;
+    BigInteger pivot = 1;   // the last pivot, 1 if there is none
+    int sign = 1;           // -1 if the rows were swapped an odd number of times
+};
+
+// @brief Run body(i) for every i in [begin, end), split into one range per thread. An
+//        exception in a thread is rethrown here, after every thread has finished.
+template<class Body>
+void parallel_for(std::size_t begin, std::size_t end, unsigned threads, const Body& body) {
+    if (threads <= 1 || end - begin <= 1) {
+        for (std::size_t i = begin; i < end; i++) {
+            body(i);
+        }
+        return;
+    }
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    std::size_t chunk = (end - begin + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::size_t first = std::min(end, begin + t * chunk), last = std::min(end, first + chunk);
+            try {
+                for (std::size_t i = first; i < last; i++) {
+                    body(i);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// @brief The rows of [a | b] as integers: each row is multiplied by the lcm of the
+//        denominators in it. scale is set to the product of these lcms.
+IntegerRows integer_rows(const RationalMatrix& a, const RationalMatrix& b, BigInteger& scale) {
+    IntegerRows result(a.row_count());
+    scale = 1;
+    for (std::size_t i = 0; i < a.row_count(); i++) {
+        BigInteger lcm = 1;
+        for (std::size_t j = 0; j < a.col_count() + b.col_count(); j++) {
+            const BigFraction& x = j < a.col_count() ? a.get(i, j) : b.get(i, j - a.col_count());
+            if (x.get_denominator() != 1) {
+                lcm = lcm / BigInteger::gcd(lcm, x.get_denominator()) * x.get_denominator();
+            }
+        }
+        result[i].reserve(a.col_count() + b.col_count());
+        for (std::size_t j = 0; j < a.col_count() + b.col_count(); j++) {
+            const BigFraction& x = j < a.col_count() ? a.get(i, j) : b.get(i, j - a.col_count());
+            result[i].push_back(lcm == 1 ? x.get_numerator() : x.get_numerator() * (lcm / x.get_denominator()));
+        }
+        scale = scale * lcm;
+    }
+    return result;
+}
+
+// @brief Bareiss' fraction-free elimination, looking for pivots in the first cols columns of a
+//        and updating whole rows. Every entry stays an integer (a minor of a), and the pivots
+//        of the echelon form are kept in place. With jordan set, the rows above each pivot are
+//        eliminated too, and every pivot ends up equal to the last one, so that dividing by
+//        it gives the reduced row echelon form.
+Elimination eliminate(IntegerRows& a, std::size_t cols, bool jordan, unsigned threads) {
+    Elimination result;
+    std::size_t width = a.empty() ? 0 : a[0].size();
+    for (std::size_t c = 0; c < cols && result.rank < a.size(); c++) {
+        std::size_t r = result.rank;
+        std::size_t p = r;
+        while (p < a.size() && a[p][c].is_zero()) {
+            p++;
+        }
+        if (p == a.size()) {
+            continue;
+        }
+        if (p != r) {
+            std::swap(a[p], a[r]);
+            result.sign = -result.sign;
+        }
+
+        const BigInteger& pivot = a[r][c];
+        const BigInteger& previous = result.pivot;
+        bool exact = previous == 1;
+        // The rows below the pivot are zero left of c; those above are not, unless the
+        // column of every entry there holds a pivot
+        auto update_row = [&](std::size_t i) {
+            if (i == r) {
+                return;
+            }
+            std::vector<BigInteger>& row = a[i];
+            BigInteger factor = row[c];
+            for (std::size_t j = i < r ? 0 : c + 1; j < width; j++) {
+                if (j == c) {
+                    continue;
+                }
+                BigInteger x = factor.is_zero() ? pivot * row[j] : pivot * row[j] - factor * a[r][j];
+                row[j] = exact ? x : x / previous;
+            }
+            row[c] = 0;
+        };
+        std::size_t first = jordan ? 0 : r + 1;
+        bool parallel = (a.size() - first) * (width - c) >= parallel_entries;
+        parallel_for(first, a.size(), parallel ? threads : 1, update_row);
+
+        result.pivot = pivot;
+        result.rank++;
+    }
+    return result;
+}
+
+// @brief Back substitution after eliminate() on [A | B], with A square and nonsingular, so
+//        that A is upper triangular with the last pivot d in the corner. By Cramer's rule,
+//        d * X is an integer matrix, so each row of it is
+//        (d * B[i] - sum of A[i][j] * (d * X)[j] for j > i) / A[i][i], an exact division.
+//        The columns of B are independent. d * X replaces B.
+void back_substitute(IntegerRows& a, const BigInteger& d, unsigned threads) {
+    std::size_t n = a.size(), width = n == 0 ? 0 : a[0].size();
+    auto solve_column = [&](std::size_t k) {
+        for (std::size_t i = n; i-- > 0;) {
+            BigInteger sum = d * a[i][k];
+            for (std::size_t j = i + 1; j < n; j++) {
+                if (!a[i][j].is_zero()) {
+                    sum = sum - a[i][j] * a[j][k];
+                }
+            }
+            a[i][k] = sum / a[i][i];
+        }
+    };
+    bool parallel = (width - n) * n * n / 2 >= parallel_entries;
+    parallel_for(n, width, parallel ? threads : 1, solve_column);
+}
+
+}   // namespace
+
+unsigned RationalMatrix::threads = std::thread::hardware_concurrency();
+
+void RationalMatrix::check_square() const {
+    if (rows != cols) {
+        throw "Matrix is not square";
+    }
+}
+
+// Constructors
+
+RationalMatrix::RationalMatrix(): rows(0), cols(0) {}
+
+RationalMatrix::RationalMatrix(std::size_t rows, std::size_t cols)
+    : rows(rows), cols(cols), entries(rows * cols) {}
+
+RationalMatrix::RationalMatrix(const std::vector<std::vector<Fraction>>& values)
+    : rows(values.size()), cols(values.empty() ? 0 : values[0].size()) {
+    entries.reserve(rows * cols);
+    for (const std::vector<Fraction>& row : values) {
+        if (row.size() != cols) {
+            throw "Size mismatch";
+        }
+        for (const Fraction& f : row) {
+            entries.push_back(BigFraction(f.get_numerator(), f.get_denominator()));
+        }
+    }
+}
+
+RationalMatrix RationalMatrix::identity(std::size_t n) {
+    RationalMatrix result(n, n);
+    for (std::size_t i = 0; i < n; i++) {
+        result.set(i, i, BigFraction(1, 1));
+    }
+    return result;
+}
+
+std::size_t RationalMatrix::row_count() const {
+    return rows;
+}
+
+std::size_t RationalMatrix::col_count() const {
+    return cols;
+}
+
+const BigFraction& RationalMatrix::get(std::size_t row, std::size_t col) const {
+    return entries[row * cols + col];
+}
+
+void RationalMatrix::set(std::size_t row, std::size_t col, const BigFraction& value) {
+    entries[row * cols + col] = value;
+}
+
+RationalMatrix RationalMatrix::operator*(const RationalMatrix& other) const {
+    if (cols != other.rows) {
+        throw "Size mismatch";
+    }
+    RationalMatrix result(rows, other.cols);
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < other.cols; j++) {
+            BigFraction sum;
+            for (std::size_t k = 0; k < cols; k++) {
+                sum = sum + get(i, k) * other.get(k, j);
+            }
+            result.set(i, j, sum);
+        }
+    }
+    return result;
+}
+
+bool RationalMatrix::operator==(const RationalMatrix& other) const {
+    return rows == other.rows && cols == other.cols && entries == other.entries;
+}
+
+bool RationalMatrix::operator!=(const RationalMatrix& other) const {
+    return !(*this == other);
+}
+
+// @brief Gauss-Jordan elimination of the integer rows, then one division of each entry of
+//        the nonzero rows by the last pivot
+RationalMatrix RationalMatrix::row_echelon() const {
+    BigInteger scale;
+    IntegerRows a = integer_rows(*this, RationalMatrix(rows, 0), scale);
+    Elimination e = eliminate(a, cols, true, threads);
+    RationalMatrix result(rows, cols);
+    for (std::size_t i = 0; i < e.rank; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            if (!a[i][j].is_zero()) {
+                result.set(i, j, BigFraction(a[i][j], e.pivot));
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t RationalMatrix::rank() const {
+    BigInteger scale;
+    IntegerRows a = integer_rows(*this, RationalMatrix(rows, 0), scale);
+    return eliminate(a, cols, false, threads).rank;
+}
+
+// @brief The last pivot of the fraction-free elimination is the determinant of the integer
+//        matrix, up to the sign of the row swaps; the rows were scaled by scale in all
+BigFraction RationalMatrix::determinant() const {
+    check_square();
+    BigInteger scale;
+    IntegerRows a = integer_rows(*this, RationalMatrix(rows, 0), scale);
+    Elimination e = eliminate(a, cols, false, threads);
+    if (e.rank < rows) {
+        return BigFraction();
+    }
+    return BigFraction(e.sign < 0 ? -e.pivot : e.pivot, scale);
+}
+
+RationalMatrix RationalMatrix::inverse() const {
+    check_square();
+    return solve(identity(rows));
+}
+
+// @brief Fraction-free elimination of [this | rhs] and back substitution, which leave d * X
+//        with d the last pivot, so X takes one division per entry
+RationalMatrix RationalMatrix::solve(const RationalMatrix& rhs) const {
+    check_square();
+    if (rhs.rows != rows) {
+        throw "Size mismatch";
+    }
+    BigInteger scale;
+    IntegerRows a = integer_rows(*this, rhs, scale);
+    Elimination e = eliminate(a, cols, false, threads);
+    if (e.rank < rows) {
+        throw "Matrix is singular";
+    }
+    back_substitute(a, e.pivot, threads);
+    RationalMatrix result(rows, rhs.cols);
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < rhs.cols; j++) {
+            if (!a[i][cols + j].is_zero()) {
+                result.set(i, j, BigFraction(a[i][cols + j], e.pivot));
+            }
+        }
+    }
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& os, const RationalMatrix& m) {
+    os << "[";
+    for (std::size_t i = 0; i < m.row_count(); i++) {
+        for (std::size_t j = 0; j < m.col_count(); j++) {
+            os << (j > 0 ? " " : i > 0 ? "; " : "") << m.get(i, j);
+        }
+    }
+    return os << "]";
+}
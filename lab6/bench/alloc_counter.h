@@ -0,0 +1,60 @@
+// Counts every heap allocation made through the global operator new.
+// Include this header in exactly one translation unit of a benchmark program.
+// With glibc, the live and peak heap footprint are tracked too (from malloc_usable_size).
+
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+struct AllocCounter {
+    static inline size_t count = 0;   // The number of calls to operator new
+    static inline size_t bytes = 0;   // The total number of bytes requested
+    static inline size_t live = 0;    // The number of bytes currently allocated
+    static inline size_t peak = 0;    // The largest value of live since the last reset()
+
+    static void reset() {
+        count = 0;
+        bytes = 0;
+        peak = live;
+    }
+
+    static void on_allocate(void *p) {
+#if defined(__GLIBC__)
+        live += malloc_usable_size(p);
+        peak = live > peak ? live : peak;
+#endif
+    }
+
+    static void on_free(void *p) {
+#if defined(__GLIBC__)
+        live -= malloc_usable_size(p);
+#endif
+    }
+};
+
+// Kept out of line, otherwise GCC pairs the inlined malloc/free with new/delete expressions
+// and reports -Wmismatched-new-delete at every call site.
+__attribute__((noinline)) void* operator new(size_t size) {
+    AllocCounter::count++;
+    AllocCounter::bytes += size;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    AllocCounter::on_allocate(p);
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept {
+    AllocCounter::on_free(p);
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept {
+    AllocCounter::on_free(p);
+    std::free(p);
+}
@@ -0,0 +1,85 @@
+// Benchmark: standard algorithms on Vector iterators, and range insert()/erase().
+// std::sort with the sequential and the parallel execution policy on Vector<int> and
+// std::vector<int> (the parallel policy needs TBB with libstdc++); then inserting and erasing
+// a block in the middle with one range call versus element by element.
+//
+// Usage: ./bench_algorithms [N]   (default N = 10^8)
+
+#include "bench_common.h"
+#include "vector.h"
+#include <algorithm>
+#include <vector>
+#if defined(BENCH_HAVE_TBB)
+#include <execution>
+#endif
+
+template<class Container>
+void fill_random(Container& c, long long n) {
+    std::uniform_int_distribution<int> dist;
+    c.clear();
+    c.reserve(static_cast<int>(n));
+    for (long long i = 0; i < n; i++) {
+        c.push_back(dist(bench_rng()));
+    }
+}
+
+template<class Container, class Sort>
+void bench_sort(const std::string& name, long long n, Sort sort) {
+    Container c;
+    fill_random(c, n);
+    Timer timer;
+    sort(c.begin(), c.end());
+    double ms = timer.elapsed_ms();
+    bench_report(name, n, ms);
+    if (!std::is_sorted(c.begin(), c.end())) {
+        std::cout << "\t\tnot sorted!" << std::endl;
+    }
+}
+
+// Insert and erase a block of k elements in the middle of a vector of n elements, r times
+template<class Container>
+void bench_block(const std::string& name, int n, int k, int r, bool one_by_one) {
+    Container c;
+    fill_random(c, n);
+    std::vector<int> block(k, 42);
+    Timer timer;
+    for (int round = 0; round < r; round++) {
+        int mid = c.size() / 2;
+        if (one_by_one) {
+            for (int i = 0; i < k; i++) {
+                c.insert(c.begin() + mid + i, block[i]);
+            }
+            for (int i = 0; i < k; i++) {
+                c.erase(c.begin() + mid);
+            }
+        } else {
+            c.insert(c.begin() + mid, block.begin(), block.end());
+            c.erase(c.begin() + mid, c.begin() + mid + k);
+        }
+    }
+    double ms = timer.elapsed_ms();
+    bench_report(name, static_cast<long long>(k) * r, ms);
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 100000000);
+
+    auto seq_sort = [](auto first, auto last) { std::sort(first, last); };
+    bench_sort<Vector<int>>("Vector std::sort", n, seq_sort);
+    bench_sort<std::vector<int>>("std::vector std::sort", n, seq_sort);
+#if defined(BENCH_HAVE_TBB)
+    auto par_sort = [](auto first, auto last) { std::sort(std::execution::par, first, last); };
+    bench_sort<Vector<int>>("Vector std::sort(par)", n, par_sort);
+    bench_sort<std::vector<int>>("std::vector std::sort(par)", n, par_sort);
+#else
+    std::cout << "(built without TBB: parallel std::sort skipped)" << std::endl;
+#endif
+
+    const int size = 1000000, k = 1000, r = 20;
+    bench_block<Vector<int>>("Vector range insert/erase", size, k, r, false);
+    bench_block<std::vector<int>>("std::vector range insert/erase", size, k, r, false);
+    bench_block<Vector<int>>("Vector single insert/erase", size, k, r, true);
+    bench_block<std::vector<int>>("std::vector single insert/erase", size, k, r, true);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Benchmark: tail latency of push_back.
+// Every push_back of an int is timed on its own; the latencies go to a histogram of powers of two
+// (in ns), from which the percentiles are read. The maximum is the cost of the worst growth step:
+// a copy of the whole array for Vector and std::vector, one chunk allocation for ChunkedVector.
+// The peak heap footprint shows the doubled memory of a growth step.
+//
+// Usage: ./bench_chunked [N]   (default N = 10^9, which needs about 4 GB per container;
+//        Vector and std::vector need up to 3x that at their last growth step)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "chunked_vector.h"
+#include "vector.h"
+#include <vector>
+
+// Histogram of latencies: bucket b counts the operations which took [2^(b-1), 2^b) ns
+class LatencyHistogram {
+private:
+    static const int BUCKETS = 64;
+    long long counts[BUCKETS] = {};
+    long long total = 0;
+    long long max_ns = 0;
+
+public:
+    void add(long long ns) {
+        int b = 0;
+        while (b < BUCKETS - 1 && (1LL << b) <= ns) {
+            b++;
+        }
+        counts[b]++;
+        total++;
+        max_ns = ns > max_ns ? ns : max_ns;
+    }
+
+    // Upper bound of the bucket holding the given percentile
+    long long percentile(double p) const {
+        long long rank = static_cast<long long>(total * p / 100.0);
+        long long seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b];
+            if (seen > rank) {
+                return 1LL << b;
+            }
+        }
+        return max_ns;
+    }
+
+    long long max() const {
+        return max_ns;
+    }
+};
+
+template<class Container>
+void bench_latency(const std::string& name, long long n) {
+    AllocCounter::reset();
+    LatencyHistogram histogram;
+    Timer timer;
+    {
+        Container c;
+        for (long long i = 0; i < n; i++) {
+            auto start = std::chrono::steady_clock::now();
+            c.push_back(static_cast<int>(i));
+            auto stop = std::chrono::steady_clock::now();
+            histogram.add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+    }
+    double ms = timer.elapsed_ms();
+    bench_report(name, n, ms);
+    std::cout << "\t\tp50 < " << histogram.percentile(50) << " ns, p99.99 < " << histogram.percentile(99.99)
+              << " ns, p99.9999 < " << histogram.percentile(99.9999) << " ns, max " << histogram.max() / 1e6 << " ms" << std::endl;
+    std::cout << "\t\tpeak heap: " << AllocCounter::peak / (1024 * 1024) << " MB" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 1000000000);
+
+    bench_latency<ChunkedVector<int>>("ChunkedVector<int> push_back", n);
+    bench_latency<ChunkedVector<int, 16>>("ChunkedVector<int, 16> push_back", n);
+    bench_latency<Vector<int>>("Vector<int> push_back", n);
+    bench_latency<std::vector<int>>("std::vector<int> push_back", n);
+
+    return 0;
+}
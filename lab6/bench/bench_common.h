@@ -0,0 +1,44 @@
+// Shared helpers for the Vector benchmarks.
+
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include "test_class.h"
+
+// Stopwatch measuring wall-clock time in milliseconds
+class Timer {
+private:
+    std::chrono::high_resolution_clock::time_point start_time;
+
+public:
+    Timer() : start_time(std::chrono::high_resolution_clock::now()) {}
+
+    void reset() {
+        start_time = std::chrono::high_resolution_clock::now();
+    }
+
+    double elapsed_ms() const {
+        std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start_time;
+        return duration.count();
+    }
+};
+
+// A single, fixed-seed generator so that every run sees the same input
+inline std::mt19937& bench_rng() {
+    static std::mt19937 gen(20250401);
+    return gen;
+}
+
+// Read the problem size from argv[1], falling back to the given default
+inline long long bench_size(int argc, char **argv, long long default_size) {
+    return argc > 1 ? std::atoll(argv[1]) : default_size;
+}
+
+// Print a single result line: "<name> <size> <time> ms (<ns/op> ns/op)"
+inline void bench_report(const std::string& name, long long n, double ms) {
+    std::cout << name << "\t" << n << "\t" << ms << " ms\t(" << ms * 1e6 / n << " ns/op)" << std::endl;
+}
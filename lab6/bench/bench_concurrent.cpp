@@ -0,0 +1,61 @@
+// Benchmark: scalability of concurrent appends.
+// T threads push N/T ints each into one shared container, for T = 1, 2, 4, ... up to twice the
+// number of hardware threads: ConcurrentVector (lock-free), and Vector and std::vector behind
+// a std::mutex. Reports the total time and the throughput in million appends per second.
+//
+// Usage: ./bench_concurrent [N] [max threads]   (default N = 10^7)
+
+#include "bench_common.h"
+#include "concurrent_vector.h"
+#include "vector.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template<class Append>
+double run_threads(int threads, long long n, Append append) {
+    std::vector<std::thread> workers;
+    Timer timer;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&append, t, threads, n]() {
+            for (long long i = t; i < n; i += threads) {
+                append(static_cast<int>(i));
+            }
+        });
+    }
+    for (std::thread& w : workers) {
+        w.join();
+    }
+    return timer.elapsed_ms();
+}
+
+template<class Container>
+void bench_locked(const std::string& name, int threads, long long n) {
+    Container c;
+    std::mutex m;
+    double ms = run_threads(threads, n, [&](int x) {
+        std::lock_guard<std::mutex> lock(m);
+        c.push_back(x);
+    });
+    bench_report(name + " x" + std::to_string(threads), n, ms);
+}
+
+void bench_lock_free(int threads, long long n) {
+    ConcurrentVector<int> c;
+    double ms = run_threads(threads, n, [&](int x) { c.push_back(x); });
+    bench_report("ConcurrentVector x" + std::to_string(threads), n, ms);
+}
+
+int main(int argc, char **argv) {
+    long long n = bench_size(argc, argv, 10000000);
+    int max_threads = argc > 2 ? std::atoi(argv[2]) : 2 * std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        bench_lock_free(threads, n);
+        bench_locked<Vector<int>>("mutex + Vector", threads, n);
+        bench_locked<std::vector<int>>("mutex + std::vector", threads, n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Benchmark: copy-on-write copies against deep copies.
+//  - copy latency and heap usage of K copies of a vector of N TestClass which are only read;
+//  - a read-mostly workload: a vector passed by value to a reader, with 1 call in 100 writing;
+//  - the per-write cost of the refcount check on an unshared vector of ints, and of the
+//    first write to a shared vector (the detach).
+//
+// Usage: ./bench_cow [N]   (default N = 10^5)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "cow_vector.h"
+#include "vector.h"
+
+template<class T>
+void consume(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Read every element through the const interface
+template<class Container>
+long long read_all(const Container& c) {
+    long long s = 0;
+    for (int i = 0; i < c.size(); i++) {
+        s += reinterpret_cast<const unsigned char*>(&c[i])[0];
+    }
+    return s;
+}
+
+template<class Container>
+long long reader(Container c, bool write) {
+    if (write) {
+        c.push_back(c[0]);
+    }
+    return read_all(c);
+}
+
+template<class Container>
+void bench_copies(const std::string& name, const Container& source, int copies) {
+    AllocCounter::reset();
+    size_t base = AllocCounter::live;
+    Timer timer;
+    {
+        Vector<Container> kept;
+        kept.reserve(copies);
+        for (int i = 0; i < copies; i++) {
+            kept.push_back(source);
+        }
+        double ms = timer.elapsed_ms();
+        bench_report(name + " copy", copies, ms);
+        for (int i = 0; i < copies; i++) {
+            consume(read_all(static_cast<const Container&>(kept[i])));
+        }
+        std::cout << "\t\theap held by the copies: " << (AllocCounter::peak - base) / 1024 << " KB, allocations: " << AllocCounter::count << std::endl;
+    }
+}
+
+template<class Container>
+void bench_read_mostly(const std::string& name, const Container& source, int calls) {
+    Timer timer;
+    for (int i = 0; i < calls; i++) {
+        consume(reader(source, i % 100 == 0));
+    }
+    bench_report(name + " pass by value, 1% writes", calls, timer.elapsed_ms());
+}
+
+template<class Container>
+void bench_writes(const std::string& name, int n) {
+    Container v;
+    for (int i = 0; i < n; i++) {
+        v.push_back(i);
+    }
+    Timer timer;
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < n; i++) {
+            v[i] += round;
+        }
+    }
+    bench_report(name + " v[i] += x", 10LL * n, timer.elapsed_ms());
+    consume(static_cast<const Container&>(v)[n / 2]);
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 100000));
+    const int copies = 100;
+
+    Vector<TestClass> vec;
+    for (int i = 0; i < n; i++) {
+        vec.push_back(TestClass::Random(bench_rng()));
+    }
+    CowVector<TestClass> cow(vec);
+
+    bench_copies("Vector<TestClass>", vec, copies);
+    bench_copies("CowVector<TestClass>", cow, copies);
+    bench_read_mostly("Vector<TestClass>", vec, 1000);
+    bench_read_mostly("CowVector<TestClass>", cow, 1000);
+
+    bench_writes<Vector<int>>("Vector<int>", 100 * n);
+    bench_writes<CowVector<int>>("CowVector<int>", 100 * n);
+
+    // The first write to a shared vector pays for the copy
+    CowVector<TestClass> shared(cow);
+    Timer timer;
+    shared.push_back(TestClass());
+    bench_report("CowVector<TestClass> first write (detach)", 1, timer.elapsed_ms());
+
+    return 0;
+}
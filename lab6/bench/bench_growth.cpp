@@ -0,0 +1,50 @@
+// Benchmark: growth of Vector<int> and Vector<double> by push_back.
+// Compares the original new[]-based Vector, Vector (memcpy relocation), Vector on top of
+// ReallocAllocator (in-place expansion / realloc) and std::vector.
+//
+// Usage: ./bench_growth [N]   (default N = 10^8)
+
+#include "bench_common.h"
+#include "legacy_vector.h"
+#include "realloc_allocator.h"
+#include "vector.h"
+#include <vector>
+
+template<class Container>
+void bench_growth(const std::string& name, int n) {
+    Timer timer;
+    typename Container::value_type checksum = 0;
+    {
+        Container c;
+        for (int i = 0; i < n; i++) {
+            c.push_back(static_cast<typename Container::value_type>(i));
+        }
+        checksum = c[n - 1];
+    }
+    bench_report(name, n, timer.elapsed_ms());
+    if (checksum != static_cast<typename Container::value_type>(n - 1)) {
+        std::cout << "Error: wrong last element in " << name << std::endl;
+    }
+}
+
+// LegacyVector has no value_type, give it one so bench_growth() can use it
+template<class T>
+struct LegacyVectorOf : LegacyVector<T> {
+    typedef T value_type;
+};
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 100000000));
+
+    bench_growth<LegacyVectorOf<int>>("LegacyVector<int>", n);
+    bench_growth<Vector<int>>("Vector<int>", n);
+    bench_growth<Vector<int, ReallocAllocator<int>>>("Vector<int, ReallocAllocator>", n);
+    bench_growth<std::vector<int>>("std::vector<int>", n);
+
+    bench_growth<LegacyVectorOf<double>>("LegacyVector<double>", n);
+    bench_growth<Vector<double>>("Vector<double>", n);
+    bench_growth<Vector<double, ReallocAllocator<double>>>("Vector<double, ReallocAllocator>", n);
+    bench_growth<std::vector<double>>("std::vector<double>", n);
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Benchmark: start-up cost of a large file-backed MappedVector.
+// Creates a file of N long longs (default 10 GB), syncs it and drops it from the page cache,
+// then reopens it and reads a few random elements, with the default readahead and with
+// advise_random(). Reports the time of each step and how many pages of the file became
+// resident, to show that reopening does not read the file.
+//
+// Usage: ./bench_mapped [GB] [file]   (default 10 GB in bench_mapped.bin, removed at the end)
+
+#include "bench_common.h"
+#include "mapped_vector.h"
+#include <cstdio>
+
+// Drop the clean pages of the file from the page cache
+void evict(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+// Count the resident pages of [p, p + bytes)
+long long resident_pages(const void *p, std::size_t bytes) {
+    long page = ::sysconf(_SC_PAGESIZE);
+    std::size_t pages = (bytes + page - 1) / page;
+    std::vector<unsigned char> resident(pages);
+    if (::mincore(const_cast<void*>(p), bytes, resident.data()) < 0) {
+        return -1;
+    }
+    long long count = 0;
+    for (unsigned char r : resident) {
+        count += r & 1;
+    }
+    return count;
+}
+
+int main(int argc, char **argv) {
+    long long gigabytes = bench_size(argc, argv, 10);
+    std::string path = argc > 2 ? argv[2] : "bench_mapped.bin";
+    long long n = gigabytes * (1LL << 30) / static_cast<long long>(sizeof(long long));
+    std::remove(path.c_str());
+
+    {
+        Timer timer;
+        MappedVector<long long> v(path);
+        v.resize(n);
+        long long *p = v.data();
+        for (long long i = 0; i < n; i++) {
+            p[i] = i;
+        }
+        v.sync();
+        bench_report("create + fill + sync", n, timer.elapsed_ms());
+    }
+
+    for (bool random : {false, true}) {
+        evict(path);
+        Timer timer;
+        MappedVector<long long> v(path);
+        double open_ms = timer.elapsed_ms();
+        std::cout << "reopen\t" << v.size() << " elements\t" << open_ms << " ms" << std::endl;
+        std::cout << "\t\tresident pages after reopen: " << resident_pages(v.data(), n * sizeof(long long)) << std::endl;
+        if (random) {
+            v.advise_random(true);
+        }
+
+        const int reads = 1000;
+        std::uniform_int_distribution<long long> dist(0, n - 1);
+        long long checksum = 0;
+        bool ok = true;
+        timer.reset();
+        for (int i = 0; i < reads; i++) {
+            long long index = dist(bench_rng());
+            ok = ok && v[index] == index;
+            checksum += v[index];
+        }
+        bench_report(random ? "random reads, advise_random()" : "random reads, default readahead", reads, timer.elapsed_ms());
+        std::cout << "\t\tresident pages: " << resident_pages(v.data(), n * sizeof(long long)) << " of "
+                  << (n * sizeof(long long) + 4095) / 4096 << (ok ? "" : " (wrong values!)") << ", checksum " << checksum << std::endl;
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
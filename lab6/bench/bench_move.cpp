@@ -0,0 +1,56 @@
+// Benchmark: the Vector<TestClass> test with and without move semantics.
+// Reports the time and the number of heap allocations (buffers plus string copies) for
+// push_back(const T&) of a copy-only class, push_back(T&&) and emplace_back() of TestClass.
+//
+// Usage: ./bench_move [N]   (default N = 10^6)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "vector.h"
+#include <vector>
+
+// TestClass as it was before it got move operations: every relocation copies the string
+class CopyOnlyTestClass {
+private:
+    TestClass value;
+public:
+    CopyOnlyTestClass(const TestClass& value) : value(value) {}
+    CopyOnlyTestClass(const CopyOnlyTestClass& other) : value(other.value) {}
+    CopyOnlyTestClass& operator=(const CopyOnlyTestClass& other) {
+        value = other.value;
+        return *this;
+    }
+};
+
+template<class Container, class Fill>
+void bench_fill(const std::string& name, int n, Fill fill) {
+    AllocCounter::reset();
+    Timer timer;
+    {
+        Container c;
+        for (int i = 0; i < n; i++) {
+            fill(c, i);
+        }
+    }
+    double ms = timer.elapsed_ms();
+    bench_report(name, n, ms);
+    std::cout << "\t\tallocations: " << AllocCounter::count << ", bytes: " << AllocCounter::bytes << std::endl;
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 1000000));
+    const std::string str(128, 'x');
+
+    auto push_copy_only = [&](auto& c, int i) { c.push_back(CopyOnlyTestClass(TestClass(i, i * 0.5, str))); };
+    auto push_move = [&](auto& c, int i) { c.push_back(TestClass(i, i * 0.5, str)); };
+    auto emplace = [&](auto& c, int i) { c.emplace_back(i, i * 0.5, str); };
+
+    bench_fill<Vector<CopyOnlyTestClass>>("Vector push_back(copy-only)", n, push_copy_only);
+    bench_fill<Vector<TestClass>>("Vector push_back(T&&)", n, push_move);
+    bench_fill<Vector<TestClass>>("Vector emplace_back", n, emplace);
+    bench_fill<std::vector<CopyOnlyTestClass>>("std::vector push_back(copy-only)", n, push_copy_only);
+    bench_fill<std::vector<TestClass>>("std::vector push_back(T&&)", n, push_move);
+    bench_fill<std::vector<TestClass>>("std::vector emplace_back", n, emplace);
+
+    return 0;
+}
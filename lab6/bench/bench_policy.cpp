@@ -0,0 +1,77 @@
+// Benchmark: capacity management.
+// 1. Refill-heavy: R rounds of clear() and K push_backs. The original Vector freed its buffer
+//    in clear(); Vector keeps the capacity.
+// 2. Memory-bounded: growth of a Vector<int> to N elements under each growth policy.
+//    Reports the number of growth steps, the final slack and the worst transient footprint
+//    (old + new buffer of the largest reallocation, an upper bound when realloc() grows in place),
+//    then shrink_to_fit().
+//
+// Usage: ./bench_policy [N]   (default N = 10^8, refill uses R = 1000 rounds of K = N / 1000)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "legacy_vector.h"
+#include "realloc_allocator.h"
+#include "vector.h"
+#include <vector>
+
+template<class Container>
+void bench_refill(const std::string& name, int rounds, int k) {
+    AllocCounter::reset();
+    Timer timer;
+    long long sum = 0;
+    Container c;
+    for (int r = 0; r < rounds; r++) {
+        c.clear();
+        for (int i = 0; i < k; i++) {
+            c.push_back(i + r);
+        }
+        sum += c[k - 1];
+    }
+    bench_report(name, (long long)rounds * k, timer.elapsed_ms());
+    std::cout << "\t\tallocations: " << AllocCounter::count << ", checksum: " << sum << std::endl;
+}
+
+template<class Container>
+void bench_bounded(const std::string& name, int n) {
+    Timer timer;
+    Container c;
+    int steps = 0;
+    long long peak = 0;
+    for (int i = 0; i < n; i++) {
+        int old_capacity = c.capacity();
+        c.push_back(i);
+        if (c.capacity() != old_capacity) {
+            steps++;
+            peak = std::max(peak, (long long)(old_capacity + c.capacity()) * (long long)sizeof(int));
+        }
+    }
+    double ms = timer.elapsed_ms();
+    long long slack = (long long)(c.capacity() - c.size()) * sizeof(int);
+    bench_report(name, n, ms);
+    std::cout << "\t\tgrowth steps: " << steps << ", slack: " << slack / 1048576.0 << " MiB"
+              << ", largest old + new buffer pair: " << peak / 1048576.0 << " MiB" << std::endl;
+
+    timer.reset();
+    c.shrink_to_fit();
+    std::cout << "\t\tshrink_to_fit: " << timer.elapsed_ms() << " ms, capacity " << c.capacity() << std::endl;
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 100000000));
+    const int rounds = 1000;
+    int k = std::max(1, n / rounds);
+
+    std::cout << "Refill (" << rounds << " rounds of " << k << " push_backs):" << std::endl;
+    bench_refill<LegacyVector<int>>("LegacyVector<int>", rounds, k);
+    bench_refill<Vector<int>>("Vector<int>", rounds, k);
+    bench_refill<std::vector<int>>("std::vector<int>", rounds, k);
+
+    std::cout << "Memory-bounded growth:" << std::endl;
+    bench_bounded<Vector<int, std::allocator<int>, GrowDouble>>("Vector<int> 2x", n);
+    bench_bounded<Vector<int, std::allocator<int>, GrowOneAndHalf>>("Vector<int> 1.5x", n);
+    bench_bounded<Vector<int, ReallocAllocator<int>, GrowOneAndHalf>>("Vector<int> 1.5x, realloc", n);
+    bench_bounded<Vector<int, ReallocAllocator<int>, GrowChunk<1 << 20>>>("Vector<int> +1Mi, realloc", n);
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Benchmark: push_back of heavy TestClass objects.
+// Compares the original new[]-based Vector, the allocator-aware Vector (with std::allocator
+// and with the lab7 mAllocator pool) and std::vector.
+//
+// Usage: ./bench_push_back [N]   (default N = 10^7)
+
+#include "bench_common.h"
+#include "legacy_vector.h"
+#include "mallocator.h"
+#include "vector.h"
+#include <vector>
+
+const int PrototypeNum = 1024;
+
+template<class Container>
+void bench_push_back(const std::string& name, const std::vector<TestClass>& prototypes, int n) {
+    Timer timer;
+    {
+        Container c;
+        for (int i = 0; i < n; i++) {
+            c.push_back(prototypes[i % PrototypeNum]);
+        }
+        bench_report(name + " push_back", n, timer.elapsed_ms());
+        timer.reset();
+    }
+    bench_report(name + " destroy", n, timer.elapsed_ms());
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 10000000));
+
+    std::vector<TestClass> prototypes;
+    for (int i = 0; i < PrototypeNum; i++) {
+        prototypes.push_back(TestClass::Random(bench_rng()));
+    }
+
+    bench_push_back<LegacyVector<TestClass>>("LegacyVector<TestClass>", prototypes, n);
+    bench_push_back<Vector<TestClass>>("Vector<TestClass>", prototypes, n);
+    bench_push_back<Vector<TestClass, mAllocator<TestClass>>>("Vector<TestClass, mAllocator>", prototypes, n);
+    bench_push_back<std::vector<TestClass>>("std::vector<TestClass>", prototypes, n);
+
+    return 0;
+}
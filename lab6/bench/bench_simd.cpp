@@ -0,0 +1,80 @@
+// Benchmark: bulk kernels of NumericVector against plain loops.
+// For double and int: fill, sum, min, max, dot, axpy, transform and compare, first as the plain
+// element-by-element loops over Vector that lab6 uses, then with NumericVector's kernels
+// forced to scalar, SSE2 and AVX2 (the best supported set is picked by default).
+//
+// Usage: ./bench_simd [N]   (default N = 10^8)
+
+#include "bench_common.h"
+#include "numeric_vector.h"
+#include "vector.h"
+
+// Keep the result alive so the loop is not optimized away
+template<class T>
+void consume(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<class Run>
+void bench_kernel(const std::string& name, long long n, Run run) {
+    Timer timer;
+    run();
+    bench_report(name, n, timer.elapsed_ms());
+}
+
+template<class T>
+void bench_plain(const std::string& type, int n) {
+    Vector<T> x, y;
+    for (int i = 0; i < n; i++) {
+        x.push_back(static_cast<T>(bench_rng()() % 1000));
+        y.push_back(static_cast<T>(bench_rng()() % 1000));
+    }
+    std::string prefix = "plain " + type + " ";
+    bench_kernel(prefix + "fill", n, [&]() { for (int i = 0; i < n; i++) { y[i] = 1; } consume(y[n / 2]); });
+    bench_kernel(prefix + "sum", n, [&]() { simd::sum_t<T> s = 0; for (int i = 0; i < n; i++) { s += x[i]; } consume(s); });
+    bench_kernel(prefix + "min", n, [&]() { T m = x[0]; for (int i = 1; i < n; i++) { m = x[i] < m ? x[i] : m; } consume(m); });
+    bench_kernel(prefix + "max", n, [&]() { T m = x[0]; for (int i = 1; i < n; i++) { m = x[i] > m ? x[i] : m; } consume(m); });
+    bench_kernel(prefix + "dot", n, [&]() { simd::sum_t<T> s = 0; for (int i = 0; i < n; i++) { s += static_cast<simd::sum_t<T>>(x[i]) * y[i]; } consume(s); });
+    bench_kernel(prefix + "axpy", n, [&]() { for (int i = 0; i < n; i++) { y[i] = 3 * x[i] + y[i]; } consume(y[n / 2]); });
+    bench_kernel(prefix + "transform", n, [&]() { for (int i = 0; i < n; i++) { y[i] = y[i] * 2 + 1; } consume(y[n / 2]); });
+    y = x;
+    bench_kernel(prefix + "compare", n, [&]() { int i = 0; while (i < n && x[i] == y[i]) { i++; } consume(i); });
+}
+
+template<class T>
+void bench_numeric(const std::string& type, int n, simd::isa target) {
+    simd::set_isa(target);
+    NumericVector<T> x, y;
+    x.reserve(n);
+    y.reserve(n);
+    for (int i = 0; i < n; i++) {
+        x.push_back(static_cast<T>(bench_rng()() % 1000));
+        y.push_back(static_cast<T>(bench_rng()() % 1000));
+    }
+    std::string prefix = std::string(simd::isa_name(simd::active_isa())) + " " + type + " ";
+    bench_kernel(prefix + "fill", n, [&]() { y.fill(1); consume(y[n / 2]); });
+    bench_kernel(prefix + "sum", n, [&]() { consume(x.sum()); });
+    bench_kernel(prefix + "min", n, [&]() { consume(x.min()); });
+    bench_kernel(prefix + "max", n, [&]() { consume(x.max()); });
+    bench_kernel(prefix + "dot", n, [&]() { consume(x.dot(y)); });
+    bench_kernel(prefix + "axpy", n, [&]() { y.axpy(3, x); consume(y[n / 2]); });
+    bench_kernel(prefix + "transform", n, [&]() { y.transform([](T v) { return v * 2 + 1; }); consume(y[n / 2]); });
+    y = x;
+    bench_kernel(prefix + "compare", n, [&]() { consume(x.compare(y)); });
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 100000000));
+    std::cout << "detected: " << simd::isa_name(simd::detect_isa()) << std::endl;
+
+    bench_plain<double>("double", n);
+    for (simd::isa target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2}) {
+        bench_numeric<double>("double", n, target);
+    }
+    bench_plain<int>("int", n);
+    for (simd::isa target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2}) {
+        bench_numeric<int>("int", n, target);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Benchmark: many small vectors.
+// Mimics the tiny vectors built across the labs: per-student course score lists (ints),
+// the valid-direction list built in Game::get_command (short strings) and per-diary
+// Content line vectors. Each workload builds, reads and destroys M vectors.
+//
+// Usage: ./bench_small_vector [M]   (default M = 10^6)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "small_vector.h"
+#include "vector.h"
+#include <vector>
+
+const char *DirectionNames[] = {"north", "south", "east", "west", "up", "down"};
+
+template<class Container>
+void bench_course_lists(const std::string& name, const std::vector<int>& sizes) {
+    AllocCounter::reset();
+    Timer timer;
+    long long sum = 0;
+    for (int n : sizes) {
+        Container scores;
+        for (int i = 0; i < n; i++) {
+            scores.push_back(60 + i);
+        }
+        for (int i = 0; i < n; i++) {
+            sum += scores[i];
+        }
+    }
+    bench_report(name, sizes.size(), timer.elapsed_ms());
+    std::cout << "\t\tallocations: " << AllocCounter::count << ", checksum: " << sum << std::endl;
+}
+
+template<class Container>
+void bench_directions(const std::string& name, const std::vector<int>& masks) {
+    AllocCounter::reset();
+    Timer timer;
+    size_t total = 0;
+    for (int mask : masks) {
+        Container valid_directions;
+        for (int i = 0; i < 6; i++) {
+            if (mask & (1 << i)) {
+                valid_directions.emplace_back(DirectionNames[i]);
+            }
+        }
+        for (int i = 0; i < (int)valid_directions.size(); i++) {
+            total += valid_directions[i].size();
+        }
+    }
+    bench_report(name, masks.size(), timer.elapsed_ms());
+    std::cout << "\t\tallocations: " << AllocCounter::count << ", checksum: " << total << std::endl;
+}
+
+int main(int argc, char **argv) {
+    int m = static_cast<int>(bench_size(argc, argv, 1000000));
+
+    std::vector<int> sizes(m), masks(m);
+    std::uniform_int_distribution<int> size_dist(0, 8), mask_dist(0, 63);
+    for (int i = 0; i < m; i++) {
+        sizes[i] = size_dist(bench_rng());
+        masks[i] = mask_dist(bench_rng());
+    }
+
+    std::cout << "Course lists (0-8 ints):" << std::endl;
+    bench_course_lists<Vector<int>>("Vector<int>", sizes);
+    bench_course_lists<SmallVector<int, 8>>("SmallVector<int, 8>", sizes);
+    bench_course_lists<std::vector<int>>("std::vector<int>", sizes);
+
+    std::cout << "Direction lists (0-6 short strings):" << std::endl;
+    bench_directions<Vector<std::string>>("Vector<std::string>", masks);
+    bench_directions<SmallVector<std::string, 6>>("SmallVector<std::string, 6>", masks);
+    bench_directions<std::vector<std::string>>("std::vector<std::string>", masks);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Benchmark: column aggregation over records stored as an array of structs (Vector<Struct>)
+// and as a structure of arrays (SoAVector).
+// Two record shapes from the labs: TestClass (int, double, string) and the lab1 Record
+// (id, name, 3 scores, average). Each scan reads one or two fields of every record: the AoS
+// scan drags the whole record through the cache, the SoA scan only the columns it needs,
+// which can also be handed to the SIMD kernels.
+//
+// Usage: ./bench_soa [N]   (default N = 10^7)
+
+#include "bench_common.h"
+#include "numeric_vector.h"
+#include "soa_vector.h"
+#include "vector.h"
+
+struct TestRecord {
+    int int_field;
+    double double_field;
+    std::string string_field;
+};
+
+struct StudentRecord {
+    int id;
+    std::string name;
+    int score[3];
+    float avg_score;
+};
+
+template<class T>
+void consume(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<class Run>
+void bench_scan(const std::string& name, long long n, Run run) {
+    Timer timer;
+    for (int round = 0; round < 10; round++) {
+        run();
+    }
+    bench_report(name, 10 * n, timer.elapsed_ms());
+}
+
+int main(int argc, char **argv) {
+    int n = static_cast<int>(bench_size(argc, argv, 10000000));
+
+    {
+        Vector<TestRecord> aos;
+        SoAVector<int, double, std::string> soa;
+        aos.reserve(n);
+        soa.reserve(n);
+        for (int i = 0; i < n; i++) {
+            TestRecord r{static_cast<int>(bench_rng()() % 1000000), bench_rng()() / 4294.967296, "record"};
+            soa.emplace_back(r.int_field, r.double_field, r.string_field);
+            aos.push_back(std::move(r));
+        }
+        std::cout << "TestClass: sizeof(AoS record) = " << sizeof(TestRecord) << ", bytes per SoA column = 4, 8, " << sizeof(std::string) << std::endl;
+
+        bench_scan("AoS sum(double_field)", n, [&]() {
+            double s = 0;
+            for (int i = 0; i < n; i++) {
+                s += aos[i].double_field;
+            }
+            consume(s);
+        });
+        bench_scan("SoA sum(double_field)", n, [&]() {
+            Span<const double> column = static_cast<const SoAVector<int, double, std::string>&>(soa).column<1>();
+            double s = 0;
+            for (int i = 0; i < column.size(); i++) {
+                s += column[i];
+            }
+            consume(s);
+        });
+        bench_scan("SoA simd::sum(double_field)", n, [&]() {
+            Span<double> column = soa.column<1>();
+            consume(simd::sum(column.data(), column.size()));
+        });
+        bench_scan("AoS count(int_field < 500000)", n, [&]() {
+            int count = 0;
+            for (int i = 0; i < n; i++) {
+                count += aos[i].int_field < 500000;
+            }
+            consume(count);
+        });
+        bench_scan("SoA count(int_field < 500000)", n, [&]() {
+            Span<int> column = soa.column<0>();
+            int count = 0;
+            for (int i = 0; i < column.size(); i++) {
+                count += column[i] < 500000;
+            }
+            consume(count);
+        });
+    }
+
+    {
+        Vector<StudentRecord> aos;
+        SoAVector<int, std::string, int, int, int, float> soa;
+        aos.reserve(n);
+        soa.reserve(n);
+        for (int i = 0; i < n; i++) {
+            StudentRecord r{i, "student", {0, 0, 0}, 0.0f};
+            for (int& score : r.score) {
+                score = static_cast<int>(bench_rng()() % 101);
+            }
+            r.avg_score = (r.score[0] + r.score[1] + r.score[2]) / 3.0f;
+            soa.emplace_back(r.id, r.name, r.score[0], r.score[1], r.score[2], r.avg_score);
+            aos.push_back(std::move(r));
+        }
+        std::cout << "Record: sizeof(AoS record) = " << sizeof(StudentRecord) << std::endl;
+
+        bench_scan("AoS mean(score[0])", n, [&]() {
+            long long s = 0;
+            for (int i = 0; i < n; i++) {
+                s += aos[i].score[0];
+            }
+            consume(static_cast<double>(s) / n);
+        });
+        bench_scan("SoA mean(score[0])", n, [&]() {
+            Span<int> column = soa.column<2>();
+            long long s = 0;
+            for (int i = 0; i < column.size(); i++) {
+                s += column[i];
+            }
+            consume(static_cast<double>(s) / n);
+        });
+        bench_scan("SoA simd::sum(score[0])", n, [&]() {
+            Span<int> column = soa.column<2>();
+            consume(static_cast<double>(simd::sum(column.data(), column.size())) / n);
+        });
+        bench_scan("AoS max(avg_score)", n, [&]() {
+            float m = 0;
+            for (int i = 0; i < n; i++) {
+                m = aos[i].avg_score > m ? aos[i].avg_score : m;
+            }
+            consume(m);
+        });
+        bench_scan("SoA max(avg_score)", n, [&]() {
+            Span<float> column = soa.column<5>();
+            float m = 0;
+            for (int i = 0; i < column.size(); i++) {
+                m = column[i] > m ? column[i] : m;
+            }
+            consume(m);
+        });
+    }
+
+    return 0;
+}
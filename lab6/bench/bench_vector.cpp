@@ -0,0 +1,142 @@
+// Benchmark harness for the operations the difftest in src/main.cpp exercises.
+// Times push_back, indexed read, copy, clear-and-refill and growth for int, double and
+// TestClass at several sizes, for Vector and std::vector, and prints ns/op and heap
+// allocations per operation. The inputs are generated up front from the shared fixed-seed
+// generator, so neither the timing nor the results depend on random number setup.
+//
+// Usage: ./bench_vector [ops per measurement]   (default 10^7; TestClass uses a tenth of it)
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "vector.h"
+#include <cstdio>
+#include <vector>
+
+template<class T>
+void consume(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<class T> T make_input();
+template<> int make_input<int>() { return static_cast<int>(bench_rng()() % 1000000); }
+template<> double make_input<double>() { return bench_rng()() / 4294.967296; }
+template<> TestClass make_input<TestClass>() { return TestClass::Random(bench_rng()); }
+
+// Fold an element into a checksum without copying it
+template<class T>
+long long checksum_of(const T& x) {
+    if constexpr (std::is_arithmetic<T>::value) {
+        return static_cast<long long>(x);
+    } else {
+        return reinterpret_cast<const unsigned char*>(&x)[0];
+    }
+}
+
+struct Result {
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+// Run body(rounds) once, where body performs rounds * n operations
+template<class Body>
+Result measure(long long ops, Body body) {
+    AllocCounter::reset();
+    Timer timer;
+    body();
+    double ms = timer.elapsed_ms();
+    return Result{ms * 1e6 / ops, static_cast<double>(AllocCounter::count) / ops};
+}
+
+template<class Container>
+Result run_op(const std::string& op, const std::vector<typename Container::value_type>& input, int rounds) {
+    int n = static_cast<int>(input.size());
+    long long ops = static_cast<long long>(rounds) * n;
+
+    if (op == "push_back") {
+        return measure(ops, [&]() {
+            for (int r = 0; r < rounds; r++) {
+                Container c;
+                c.reserve(n);
+                for (int i = 0; i < n; i++) {
+                    c.push_back(input[i]);
+                }
+                consume(c.size());
+            }
+        });
+    }
+    if (op == "growth") {
+        return measure(ops, [&]() {
+            for (int r = 0; r < rounds; r++) {
+                Container c;
+                for (int i = 0; i < n; i++) {
+                    c.push_back(input[i]);
+                }
+                consume(c.size());
+            }
+        });
+    }
+
+    Container c;
+    for (int i = 0; i < n; i++) {
+        c.push_back(input[i]);
+    }
+    if (op == "read") {
+        return measure(ops, [&]() {
+            long long s = 0;
+            for (int r = 0; r < rounds; r++) {
+                for (int i = 0; i < n; i++) {
+                    s += checksum_of(c[i]);
+                }
+            }
+            consume(s);
+        });
+    }
+    if (op == "copy") {
+        return measure(ops, [&]() {
+            for (int r = 0; r < rounds; r++) {
+                Container copy(c);
+                consume(copy.size());
+            }
+        });
+    }
+    // clear-refill
+    return measure(ops, [&]() {
+        for (int r = 0; r < rounds; r++) {
+            c.clear();
+            for (int i = 0; i < n; i++) {
+                c.push_back(input[i]);
+            }
+        }
+        consume(c.size());
+    });
+}
+
+template<class T>
+void bench_type(const std::string& type, long long budget) {
+    for (int n : {1000, 100000, 1000000}) {
+        std::vector<T> input;
+        input.reserve(n);
+        for (int i = 0; i < n; i++) {
+            input.push_back(make_input<T>());
+        }
+        int rounds = static_cast<int>(std::max<long long>(1, budget / n));
+        for (const char *op : {"push_back", "read", "copy", "clear-refill", "growth"}) {
+            Result mine = run_op<Vector<T>>(op, input, rounds);
+            Result std_result = run_op<std::vector<T>>(op, input, rounds);
+            std::printf("%-12s %-10s %8d %10.3f %10.3f %12.5f %12.5f\n", op, type.c_str(), n,
+                        mine.ns_per_op, std_result.ns_per_op, mine.allocs_per_op, std_result.allocs_per_op);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    long long budget = bench_size(argc, argv, 10000000);
+
+    std::printf("%-12s %-10s %8s %10s %10s %12s %12s\n", "op", "type", "size", "Vector", "std::vector", "Vector", "std::vector");
+    std::printf("%-12s %-10s %8s %10s %10s %12s %12s\n", "", "", "", "ns/op", "ns/op", "allocs/op", "allocs/op");
+    bench_type<int>("int", budget);
+    bench_type<double>("double", budget);
+    bench_type<TestClass>("TestClass", budget / 10);
+
+    return 0;
+}
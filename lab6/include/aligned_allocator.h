@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/*
+ * Class template AlignedAllocator
+ * An allocator whose blocks start on an Align-byte boundary and whose size is rounded up to a
+ * multiple of Align. A SIMD kernel may then use aligned loads from the first element, and a full
+ * vector load at the tail never crosses into another block or page.
+ */
+template<class T, std::size_t Align = 64>
+class AlignedAllocator {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Align must be a power of two, at least alignof(T)");
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    static constexpr std::size_t alignment = Align;
+
+    template<class U>
+    struct rebind {
+        typedef AlignedAllocator<U, Align> other;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template<class U> AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    /*
+     * @brief Allocate raw memory for n objects of type T, aligned and padded to Align bytes.
+     */
+    T* allocate(size_type n) {
+        return static_cast<T*>(::operator new(padded_bytes(n), std::align_val_t(Align)));
+    }
+
+    /*
+     * @brief Free the memory at p.
+     */
+    void deallocate(T *p, size_type) noexcept {
+        ::operator delete(static_cast<void*>(p), std::align_val_t(Align));
+    }
+
+    /*
+     * @brief Return the size in bytes of the block holding n objects.
+     */
+    static size_type padded_bytes(size_type n) {
+        return (n * sizeof(T) + Align - 1) / Align * Align;
+    }
+
+    bool operator==(const AlignedAllocator&) const noexcept { return true; }
+    bool operator!=(const AlignedAllocator&) const noexcept { return false; }
+};
@@ -0,0 +1,509 @@
+#pragma once
+#include "vector.h"
+
+/*
+ * Class template ChunkedVector
+ * A segmented vector: the elements live in fixed-size chunks of 2^ChunkShift elements, and a
+ * small directory (a Vector of chunk pointers) records where each chunk is. Growing adds one
+ * chunk and never moves an element, so references, pointers and iterators stay valid until the
+ * element is removed, and there is no copy of the whole array and no doubled peak memory.
+ * Indexing is O(1): one shift and mask, plus one extra indirection through the directory.
+ */
+template<class T, int ChunkShift = 12, class Alloc = std::allocator<T>>
+class ChunkedVector {
+    static_assert(ChunkShift >= 0 && ChunkShift < 31, "ChunkedVector chunk size must fit in an int");
+
+    template<bool IsConst> class basic_iterator;
+
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    static constexpr int chunk_size = 1 << ChunkShift;
+
+    ChunkedVector();
+    ChunkedVector(const ChunkedVector<T, ChunkShift, Alloc>& r);
+    ChunkedVector(ChunkedVector<T, ChunkShift, Alloc>&& r) noexcept;
+    ~ChunkedVector();
+
+    ChunkedVector<T, ChunkShift, Alloc>& operator=(const ChunkedVector<T, ChunkShift, Alloc>& r);
+    ChunkedVector<T, ChunkShift, Alloc>& operator=(ChunkedVector<T, ChunkShift, Alloc>&& r) noexcept(
+        std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Alloc>::is_always_equal::value);
+
+    T& operator[](int index);
+    const T& operator[](int index) const;
+    T& at(int index);
+    const T& at(int index) const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    int size() const;
+    int capacity() const;
+    void push_back(const T& x);
+    void push_back(T&& x);
+    template<class... Args> T& emplace_back(Args&&... args);
+    void pop_back();
+    void clear();
+    bool empty() const;
+
+    void reserve(int new_capacity);
+    void shrink_to_fit();
+
+    void swap(ChunkedVector<T, ChunkShift, Alloc>& r) noexcept;
+    Alloc get_allocator() const;
+
+private:
+    typedef std::allocator_traits<Alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<T*> directory_allocator;
+
+    static constexpr int chunk_mask = chunk_size - 1;
+
+    T* slot(int index) const;
+    void add_chunk();
+    void copy_elements_from(const ChunkedVector<T, ChunkShift, Alloc>& r);
+    void steal(ChunkedVector<T, ChunkShift, Alloc>& r) noexcept;
+    void release();
+
+    Alloc m_allocator;                              // The allocator which provides the chunks
+    Vector<T*, directory_allocator> m_chunks;       // The directory: the address of every chunk, in order
+    int m_nSize;                                    // The number of elements in the vector
+};
+
+
+/*
+ * Class template ChunkedVector::basic_iterator
+ * A random-access iterator made of the container and an index. Unlike a pointer, it stays
+ * valid while the vector grows.
+ */
+template<class T, int ChunkShift, class Alloc>
+template<bool IsConst>
+class ChunkedVector<T, ChunkShift, Alloc>::basic_iterator {
+    typedef std::conditional_t<IsConst, const ChunkedVector<T, ChunkShift, Alloc>, ChunkedVector<T, ChunkShift, Alloc>> container_type;
+
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::conditional_t<IsConst, const T*, T*> pointer;
+    typedef std::conditional_t<IsConst, const T&, T&> reference;
+
+    basic_iterator(): m_pContainer(nullptr), m_nIndex(0) {}
+    basic_iterator(container_type *container, int index): m_pContainer(container), m_nIndex(index) {}
+    // An iterator converts to a const_iterator
+    template<bool WasConst, class = std::enable_if_t<IsConst && !WasConst>>
+    basic_iterator(const basic_iterator<WasConst>& r): m_pContainer(r.m_pContainer), m_nIndex(r.m_nIndex) {}
+
+    reference operator*() const { return (*m_pContainer)[m_nIndex]; }
+    pointer operator->() const { return &(*m_pContainer)[m_nIndex]; }
+    reference operator[](difference_type n) const { return (*m_pContainer)[m_nIndex + static_cast<int>(n)]; }
+
+    basic_iterator& operator++() { m_nIndex++; return *this; }
+    basic_iterator& operator--() { m_nIndex--; return *this; }
+    basic_iterator operator++(int) { basic_iterator old = *this; m_nIndex++; return old; }
+    basic_iterator operator--(int) { basic_iterator old = *this; m_nIndex--; return old; }
+    basic_iterator& operator+=(difference_type n) { m_nIndex += static_cast<int>(n); return *this; }
+    basic_iterator& operator-=(difference_type n) { m_nIndex -= static_cast<int>(n); return *this; }
+    basic_iterator operator+(difference_type n) const { return basic_iterator(m_pContainer, m_nIndex + static_cast<int>(n)); }
+    basic_iterator operator-(difference_type n) const { return basic_iterator(m_pContainer, m_nIndex - static_cast<int>(n)); }
+    friend basic_iterator operator+(difference_type n, const basic_iterator& it) { return it + n; }
+    difference_type operator-(const basic_iterator& r) const { return m_nIndex - r.m_nIndex; }
+
+    bool operator==(const basic_iterator& r) const { return m_nIndex == r.m_nIndex; }
+    bool operator!=(const basic_iterator& r) const { return m_nIndex != r.m_nIndex; }
+    bool operator<(const basic_iterator& r) const { return m_nIndex < r.m_nIndex; }
+    bool operator>(const basic_iterator& r) const { return m_nIndex > r.m_nIndex; }
+    bool operator<=(const basic_iterator& r) const { return m_nIndex <= r.m_nIndex; }
+    bool operator>=(const basic_iterator& r) const { return m_nIndex >= r.m_nIndex; }
+
+private:
+    template<bool> friend class basic_iterator;
+
+    container_type *m_pContainer;   // The vector the iterator walks over
+    int m_nIndex;                   // The index of the current element
+};
+
+
+/*
+ * @brief Default constructor. Creates an empty vector without any chunk.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>::ChunkedVector(): m_allocator(), m_chunks(), m_nSize(0) {}
+
+/*
+ * @brief Copy constructor. Only the chunks holding live elements are allocated.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>::ChunkedVector(const ChunkedVector<T, ChunkShift, Alloc>& r)
+    : m_allocator(alloc_traits::select_on_container_copy_construction(r.m_allocator)), m_chunks(), m_nSize(0) {
+    try {
+        copy_elements_from(r);
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+/*
+ * @brief Move constructor. Takes over the chunks of r and leaves r empty.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>::ChunkedVector(ChunkedVector<T, ChunkShift, Alloc>&& r) noexcept
+    : m_allocator(std::move(r.m_allocator)), m_chunks(), m_nSize(0) {
+    steal(r);
+}
+
+/*
+ * @brief Destructor. Destroys the elements and frees every chunk.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>::~ChunkedVector() {
+    release();
+}
+
+/*
+ * @brief Copy assignment. The chunks already allocated are reused.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>& ChunkedVector<T, ChunkShift, Alloc>::operator=(const ChunkedVector<T, ChunkShift, Alloc>& r) {
+    if (this == &r) {
+        return *this;
+    }
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        release();
+        m_allocator = r.m_allocator;
+    } else {
+        clear();
+    }
+    copy_elements_from(r);
+    return *this;
+}
+
+/*
+ * @brief Move assignment. Takes over the chunks of r when the allocators allow it,
+ *        otherwise the elements are moved one by one into chunks of this allocator.
+ */
+template<class T, int ChunkShift, class Alloc>
+ChunkedVector<T, ChunkShift, Alloc>& ChunkedVector<T, ChunkShift, Alloc>::operator=(ChunkedVector<T, ChunkShift, Alloc>&& r) noexcept(
+    std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Alloc>::is_always_equal::value) {
+    if (this == &r) {
+        return *this;
+    }
+    constexpr bool can_steal = alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value;
+    if constexpr (can_steal) {
+        release();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            m_allocator = std::move(r.m_allocator);
+        }
+        steal(r);
+    } else {
+        clear();
+        for (int i = 0; i < r.m_nSize; i++) {
+            emplace_back(std::move(r[i]));
+        }
+        r.release();
+    }
+    return *this;
+}
+
+/*
+ * @brief Return the element at the given index.
+ * @param index The index of the element to return.
+ */
+template<class T, int ChunkShift, class Alloc>
+T& ChunkedVector<T, ChunkShift, Alloc>::operator[](int index) {
+    return *slot(index);
+}
+
+template<class T, int ChunkShift, class Alloc>
+const T& ChunkedVector<T, ChunkShift, Alloc>::operator[](int index) const {
+    return *slot(index);
+}
+
+/*
+ * @brief Return the element at the given index. If the index is out of range, throw an exception.
+ * @param index The index of the element to return.
+ */
+template<class T, int ChunkShift, class Alloc>
+T& ChunkedVector<T, ChunkShift, Alloc>::at(int index) {
+    if (index < 0 || index >= m_nSize) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *slot(index);
+}
+
+template<class T, int ChunkShift, class Alloc>
+const T& ChunkedVector<T, ChunkShift, Alloc>::at(int index) const {
+    if (index < 0 || index >= m_nSize) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *slot(index);
+}
+
+/*
+ * @brief Return the first element. The vector must not be empty.
+ */
+template<class T, int ChunkShift, class Alloc>
+T& ChunkedVector<T, ChunkShift, Alloc>::front() {
+    assert(m_nSize > 0);
+    return *slot(0);
+}
+
+template<class T, int ChunkShift, class Alloc>
+const T& ChunkedVector<T, ChunkShift, Alloc>::front() const {
+    assert(m_nSize > 0);
+    return *slot(0);
+}
+
+/*
+ * @brief Return the last element. The vector must not be empty.
+ */
+template<class T, int ChunkShift, class Alloc>
+T& ChunkedVector<T, ChunkShift, Alloc>::back() {
+    assert(m_nSize > 0);
+    return *slot(m_nSize - 1);
+}
+
+template<class T, int ChunkShift, class Alloc>
+const T& ChunkedVector<T, ChunkShift, Alloc>::back() const {
+    assert(m_nSize > 0);
+    return *slot(m_nSize - 1);
+}
+
+/*
+ * @brief Return an iterator to the first element.
+ */
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::iterator ChunkedVector<T, ChunkShift, Alloc>::begin() {
+    return iterator(this, 0);
+}
+
+/*
+ * @brief Return an iterator past the last element.
+ */
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::iterator ChunkedVector<T, ChunkShift, Alloc>::end() {
+    return iterator(this, m_nSize);
+}
+
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::const_iterator ChunkedVector<T, ChunkShift, Alloc>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::const_iterator ChunkedVector<T, ChunkShift, Alloc>::end() const {
+    return const_iterator(this, m_nSize);
+}
+
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::const_iterator ChunkedVector<T, ChunkShift, Alloc>::cbegin() const {
+    return const_iterator(this, 0);
+}
+
+template<class T, int ChunkShift, class Alloc>
+typename ChunkedVector<T, ChunkShift, Alloc>::const_iterator ChunkedVector<T, ChunkShift, Alloc>::cend() const {
+    return const_iterator(this, m_nSize);
+}
+
+/*
+ * @brief Return the number of elements in the vector.
+ */
+template<class T, int ChunkShift, class Alloc>
+int ChunkedVector<T, ChunkShift, Alloc>::size() const {
+    return m_nSize;
+}
+
+/*
+ * @brief Return the number of elements the allocated chunks can hold.
+ */
+template<class T, int ChunkShift, class Alloc>
+int ChunkedVector<T, ChunkShift, Alloc>::capacity() const {
+    return static_cast<int>(std::min<long long>(static_cast<long long>(m_chunks.size()) << ChunkShift, INT_MAX));
+}
+
+/*
+ * @brief Add a copy of the element to the end of the vector.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::push_back(const T& x) {
+    emplace_back(x);
+}
+
+/*
+ * @brief Move the element to the end of the vector.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::push_back(T&& x) {
+    emplace_back(std::move(x));
+}
+
+/*
+ * @brief Construct a new element at the end of the vector from args.
+ *        When the last chunk is full a new one is added; the existing elements never move,
+ *        so args may safely refer to an element of this vector.
+ * @return A reference to the new element.
+ */
+template<class T, int ChunkShift, class Alloc>
+template<class... Args>
+T& ChunkedVector<T, ChunkShift, Alloc>::emplace_back(Args&&... args) {
+    if (m_nSize == capacity()) {
+        add_chunk();
+    }
+    T *p = slot(m_nSize);
+    alloc_traits::construct(m_allocator, p, std::forward<Args>(args)...);
+    m_nSize++;
+    return *p;
+}
+
+/*
+ * @brief Remove the last element. The vector must not be empty. The chunk is kept.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::pop_back() {
+    assert(m_nSize > 0);
+    m_nSize--;
+    alloc_traits::destroy(m_allocator, slot(m_nSize));
+}
+
+/*
+ * @brief Destroy every element. The chunks are kept for reuse.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::clear() {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        for (int i = 0; i < m_nSize; i++) {
+            alloc_traits::destroy(m_allocator, slot(i));
+        }
+    }
+    m_nSize = 0;
+}
+
+/*
+ * @brief Return true if the vector is empty.
+ */
+template<class T, int ChunkShift, class Alloc>
+bool ChunkedVector<T, ChunkShift, Alloc>::empty() const {
+    return m_nSize == 0;
+}
+
+/*
+ * @brief Allocate chunks until new_capacity elements fit.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::reserve(int new_capacity) {
+    if (new_capacity <= capacity()) {
+        return;
+    }
+    m_chunks.reserve(static_cast<int>((static_cast<long long>(new_capacity) + chunk_mask) >> ChunkShift));
+    while (capacity() < new_capacity) {
+        add_chunk();
+    }
+}
+
+/*
+ * @brief Free the chunks which hold no element.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::shrink_to_fit() {
+    int used = static_cast<int>((static_cast<long long>(m_nSize) + chunk_mask) >> ChunkShift);
+    while (m_chunks.size() > used) {
+        alloc_traits::deallocate(m_allocator, m_chunks.back(), chunk_size);
+        m_chunks.pop_back();
+    }
+    m_chunks.shrink_to_fit();
+}
+
+/*
+ * @brief Exchange the contents of the two vectors. No element is touched.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::swap(ChunkedVector<T, ChunkShift, Alloc>& r) noexcept {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, r.m_allocator);
+    }
+    m_chunks.swap(r.m_chunks);
+    std::swap(m_nSize, r.m_nSize);
+}
+
+/*
+ * @brief Return a copy of the allocator.
+ */
+template<class T, int ChunkShift, class Alloc>
+Alloc ChunkedVector<T, ChunkShift, Alloc>::get_allocator() const {
+    return m_allocator;
+}
+
+/*
+ * @brief Return the address of the slot at the given index: the chunk from the directory,
+ *        then the offset inside the chunk.
+ */
+template<class T, int ChunkShift, class Alloc>
+T* ChunkedVector<T, ChunkShift, Alloc>::slot(int index) const {
+    return m_chunks[index >> ChunkShift] + (index & chunk_mask);
+}
+
+/*
+ * @brief Allocate one more chunk and record it in the directory. Only the directory
+ *        (one pointer per chunk) is ever copied when it grows.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::add_chunk() {
+    if ((static_cast<long long>(m_chunks.size()) << ChunkShift) >= INT_MAX) {
+        throw std::length_error("ChunkedVector is too long");
+    }
+    T *chunk = alloc_traits::allocate(m_allocator, chunk_size);
+    try {
+        m_chunks.push_back(chunk);
+    } catch (...) {
+        alloc_traits::deallocate(m_allocator, chunk, chunk_size);
+        throw;
+    }
+}
+
+/*
+ * @brief Append copies of the elements of r. Used by the copy constructor and copy assignment
+ *        (the vector is empty on entry).
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::copy_elements_from(const ChunkedVector<T, ChunkShift, Alloc>& r) {
+    reserve(r.m_nSize);
+    for (int i = 0; i < r.m_nSize; i++) {
+        emplace_back(r[i]);
+    }
+}
+
+/*
+ * @brief Take over the chunks of r and leave r empty. The vector must own no chunk.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::steal(ChunkedVector<T, ChunkShift, Alloc>& r) noexcept {
+    m_chunks.swap(r.m_chunks);
+    m_nSize = r.m_nSize;
+    r.m_nSize = 0;
+}
+
+/*
+ * @brief Destroy the elements, free every chunk and the directory.
+ */
+template<class T, int ChunkShift, class Alloc>
+void ChunkedVector<T, ChunkShift, Alloc>::release() {
+    clear();
+    for (int i = 0; i < m_chunks.size(); i++) {
+        alloc_traits::deallocate(m_allocator, m_chunks[i], chunk_size);
+    }
+    m_chunks.clear();
+    m_chunks.shrink_to_fit();
+}
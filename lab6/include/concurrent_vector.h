@@ -0,0 +1,316 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+ * Class template ConcurrentVector
+ * An append-only segmented vector which any number of threads may push into and read from
+ * at the same time. No lock is taken and no producer ever waits for another one:
+ *   - a producer reserves its slot with one atomic fetch-add on the reservation counter;
+ *   - segment k (k >= 1) holds 2^(FirstShift + k - 1) elements, segment 0 holds 2^FirstShift,
+ *     so a fixed directory of 32 - FirstShift segment pointers covers every int index and never
+ *     grows. A producer that finds its segment missing allocates it and installs it with a CAS
+ *     from null (release); the loser of the CAS frees its copy and uses the winner's;
+ *   - so that the CAS is rarely contended, the producer of the middle slot of segment k
+ *     allocates segment k + 1 ahead of time. Half a segment later, when producers reach it,
+ *     it is normally installed, and only the small first segments can be allocated twice.
+ *     The price is that up to one segment beyond the last element may be allocated but unused;
+ *   - after constructing its element, the producer sets the slot's ready flag (release).
+ *     A reader may use any element whose flag it has seen set (acquire).
+ * Elements never move, so references stay valid. Elements cannot be removed; the destructor
+ * must not run while producers are still pushing.
+ */
+template<class T, int FirstShift = 6, class Alloc = std::allocator<T>>
+class ConcurrentVector {
+    static_assert(FirstShift >= 0 && FirstShift < 31, "ConcurrentVector first segment must fit in an int");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "ConcurrentVector does not support over-aligned types");
+
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+
+    ConcurrentVector();
+    ConcurrentVector(const ConcurrentVector<T, FirstShift, Alloc>&) = delete;
+    ConcurrentVector<T, FirstShift, Alloc>& operator=(const ConcurrentVector<T, FirstShift, Alloc>&) = delete;
+    ~ConcurrentVector();
+
+    T& operator[](int index);
+    const T& operator[](int index) const;
+    T& at(int index);
+    const T& at(int index) const;
+
+    int size() const;
+    bool empty() const;
+    bool is_published(int index) const;
+
+    int push_back(const T& x);
+    int push_back(T&& x);
+    template<class... Args> int emplace_back(Args&&... args);
+
+private:
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<unsigned char> byte_allocator;
+    typedef std::allocator_traits<byte_allocator> byte_traits;
+
+    // The last index, INT_MAX - 1, is below 2^31, so its block index (index >> FirstShift) has
+    // at most 31 - FirstShift bits, which is the number of the last segment
+    static constexpr int SEGMENTS = 32 - FirstShift;
+
+    static int segment_of(int index);
+    static int segment_begin(int segment);
+    static int segment_size(int segment);
+    static std::size_t segment_bytes(int segment);
+
+    unsigned char* segment(int segment);
+    void free_segment(int segment, unsigned char* p);
+    T* slot(int index) const;
+    std::atomic<bool>* ready_flag(int index) const;
+
+    byte_allocator m_allocator;                                 // The allocator which provides the segments
+    std::atomic<long long> m_nReserved;                         // The number of slots handed out to producers
+    std::atomic<unsigned char*> m_pSegments[SEGMENTS];          // The directory: each segment holds its elements, then their ready flags
+};
+
+
+/*
+ * @brief Default constructor. Creates an empty vector; no segment is allocated.
+ */
+template<class T, int FirstShift, class Alloc>
+ConcurrentVector<T, FirstShift, Alloc>::ConcurrentVector(): m_allocator(), m_nReserved(0) {
+    for (int i = 0; i < SEGMENTS; i++) {
+        m_pSegments[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * @brief Destructor. Destroys the published elements and frees every segment.
+ *        No producer may be running.
+ */
+template<class T, int FirstShift, class Alloc>
+ConcurrentVector<T, FirstShift, Alloc>::~ConcurrentVector() {
+    for (int s = 0; s < SEGMENTS; s++) {
+        unsigned char *p = m_pSegments[s].load(std::memory_order_acquire);
+        if (p == nullptr) {
+            continue;
+        }
+        T *elements = reinterpret_cast<T*>(p);
+        std::atomic<bool> *flags = reinterpret_cast<std::atomic<bool>*>(p + segment_size(s) * sizeof(T));
+        for (int i = 0; i < segment_size(s); i++) {
+            if (flags[i].load(std::memory_order_acquire)) {
+                elements[i].~T();
+            }
+        }
+        free_segment(s, p);
+    }
+}
+
+/*
+ * @brief Return the element at the given index. The element must be published.
+ * @param index The index of the element to return.
+ */
+template<class T, int FirstShift, class Alloc>
+T& ConcurrentVector<T, FirstShift, Alloc>::operator[](int index) {
+    assert(is_published(index));
+    return *slot(index);
+}
+
+template<class T, int FirstShift, class Alloc>
+const T& ConcurrentVector<T, FirstShift, Alloc>::operator[](int index) const {
+    assert(is_published(index));
+    return *slot(index);
+}
+
+/*
+ * @brief Return the element at the given index. If the index is out of range or the element
+ *        is not published yet, throw an exception.
+ * @param index The index of the element to return.
+ */
+template<class T, int FirstShift, class Alloc>
+T& ConcurrentVector<T, FirstShift, Alloc>::at(int index) {
+    if (!is_published(index)) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *slot(index);
+}
+
+template<class T, int FirstShift, class Alloc>
+const T& ConcurrentVector<T, FirstShift, Alloc>::at(int index) const {
+    if (!is_published(index)) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *slot(index);
+}
+
+/*
+ * @brief Return the number of reserved slots. While producers are running, the last
+ *        slots may not be published yet (see is_published()).
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::size() const {
+    long long reserved = m_nReserved.load(std::memory_order_acquire);
+    return reserved > INT_MAX ? INT_MAX : static_cast<int>(reserved);
+}
+
+/*
+ * @brief Return true if no slot has been reserved.
+ */
+template<class T, int FirstShift, class Alloc>
+bool ConcurrentVector<T, FirstShift, Alloc>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief Return true if the element at the given index is constructed and may be read.
+ *        Lock-free; pairs with the release store of the producer.
+ */
+template<class T, int FirstShift, class Alloc>
+bool ConcurrentVector<T, FirstShift, Alloc>::is_published(int index) const {
+    if (index < 0 || index >= size()) {
+        return false;
+    }
+    unsigned char *p = m_pSegments[segment_of(index)].load(std::memory_order_acquire);
+    if (p == nullptr) {
+        return false;
+    }
+    return ready_flag(index)->load(std::memory_order_acquire);
+}
+
+/*
+ * @brief Append a copy of the element. Safe to call from several threads at once.
+ * @return The index of the new element.
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::push_back(const T& x) {
+    return emplace_back(x);
+}
+
+/*
+ * @brief Append the element by moving it. Safe to call from several threads at once.
+ * @return The index of the new element.
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::push_back(T&& x) {
+    return emplace_back(std::move(x));
+}
+
+/*
+ * @brief Construct a new element from args at the end of the vector. Safe to call from several
+ *        threads at once. The slot is reserved before anything else, so if the allocation of its
+ *        segment or the construction of the element throws, the slot stays unpublished forever:
+ *        size() counts it, but is_published() never returns true for it.
+ * @return The index of the new element.
+ */
+template<class T, int FirstShift, class Alloc>
+template<class... Args>
+int ConcurrentVector<T, FirstShift, Alloc>::emplace_back(Args&&... args) {
+    long long reserved = m_nReserved.fetch_add(1, std::memory_order_relaxed);
+    if (reserved >= INT_MAX) {
+        throw std::length_error("ConcurrentVector is too long");
+    }
+    int index = static_cast<int>(reserved);
+    int s = segment_of(index);
+    unsigned char *p = segment(s);
+    int offset = index - segment_begin(s);
+    ::new (static_cast<void*>(reinterpret_cast<T*>(p) + offset)) T(std::forward<Args>(args)...);
+    ready_flag(index)->store(true, std::memory_order_release);
+    if (offset == segment_size(s) / 2 && s + 1 < SEGMENTS) {
+        // Allocate the next segment ahead. The element is already published, so a failure here
+        // is not reported; the producers that need the segment will allocate it themselves
+        try {
+            segment(s + 1);
+        } catch (...) {
+        }
+    }
+    return index;
+}
+
+/*
+ * @brief Return the segment holding the given index.
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::segment_of(int index) {
+    int block = index >> FirstShift;
+    return block == 0 ? 0 : 32 - __builtin_clz(static_cast<unsigned>(block));
+}
+
+/*
+ * @brief Return the index of the first element of the segment.
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::segment_begin(int segment) {
+    return segment == 0 ? 0 : static_cast<int>(1LL << (FirstShift + segment - 1));
+}
+
+/*
+ * @brief Return the number of elements of the segment, at most 2^30.
+ */
+template<class T, int FirstShift, class Alloc>
+int ConcurrentVector<T, FirstShift, Alloc>::segment_size(int segment) {
+    return segment == 0 ? 1 << FirstShift : 1 << (FirstShift + segment - 1);
+}
+
+/*
+ * @brief Return the size of the segment's allocation: the elements, then one ready flag per element.
+ */
+template<class T, int FirstShift, class Alloc>
+std::size_t ConcurrentVector<T, FirstShift, Alloc>::segment_bytes(int segment) {
+    return static_cast<std::size_t>(segment_size(segment)) * (sizeof(T) + sizeof(std::atomic<bool>));
+}
+
+/*
+ * @brief Return the segment, allocating and installing it if it is missing. If another producer
+ *        installs it first, the fresh copy is freed and the installed one is returned.
+ */
+template<class T, int FirstShift, class Alloc>
+unsigned char* ConcurrentVector<T, FirstShift, Alloc>::segment(int segment) {
+    unsigned char *p = m_pSegments[segment].load(std::memory_order_acquire);
+    if (p != nullptr) {
+        return p;
+    }
+    unsigned char *fresh = byte_traits::allocate(m_allocator, segment_bytes(segment));
+    std::atomic<bool> *flags = reinterpret_cast<std::atomic<bool>*>(fresh + segment_size(segment) * sizeof(T));
+    for (int i = 0; i < segment_size(segment); i++) {
+        ::new (static_cast<void*>(flags + i)) std::atomic<bool>(false);
+    }
+    if (m_pSegments[segment].compare_exchange_strong(p, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return fresh;
+    }
+    free_segment(segment, fresh);
+    return p;
+}
+
+/*
+ * @brief Destroy the ready flags of the segment and free it. Its elements must be destroyed.
+ */
+template<class T, int FirstShift, class Alloc>
+void ConcurrentVector<T, FirstShift, Alloc>::free_segment(int segment, unsigned char* p) {
+    std::atomic<bool> *flags = reinterpret_cast<std::atomic<bool>*>(p + segment_size(segment) * sizeof(T));
+    for (int i = 0; i < segment_size(segment); i++) {
+        flags[i].~atomic();
+    }
+    byte_traits::deallocate(m_allocator, p, segment_bytes(segment));
+}
+
+/*
+ * @brief Return the address of the slot at the given index. Its segment must exist.
+ */
+template<class T, int FirstShift, class Alloc>
+T* ConcurrentVector<T, FirstShift, Alloc>::slot(int index) const {
+    int s = segment_of(index);
+    return reinterpret_cast<T*>(m_pSegments[s].load(std::memory_order_acquire)) + (index - segment_begin(s));
+}
+
+/*
+ * @brief Return the ready flag of the slot at the given index. Its segment must exist.
+ */
+template<class T, int FirstShift, class Alloc>
+std::atomic<bool>* ConcurrentVector<T, FirstShift, Alloc>::ready_flag(int index) const {
+    int s = segment_of(index);
+    unsigned char *p = m_pSegments[s].load(std::memory_order_acquire);
+    return reinterpret_cast<std::atomic<bool>*>(p + segment_size(s) * sizeof(T)) + (index - segment_begin(s));
+}
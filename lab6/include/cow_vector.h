@@ -0,0 +1,453 @@
+#pragma once
+#include "vector.h"
+#include <atomic>
+
+/*
+ * Class template CowVector
+ * A copy-on-write Vector: copies share one buffer, held with an atomic reference count, and a
+ * copy costs O(1) however large the vector is. The buffer is copied (detached) the first time a
+ * sharer mutates it, so vectors which are copied and then only read never copy their elements.
+ * Read-only access goes through the const members and never detaches.
+ *
+ * A non-const accessor (operator[], at, front, back, data, begin, end, emplace_back) returns a
+ * reference which could write into the buffer later. It detaches first and then marks the
+ * buffer unshareable, so a later copy of this vector is a deep copy and the reference can never
+ * reach another sharer. clear(), assignment and swap make the vector shareable again.
+ */
+template<class T, class Alloc = std::allocator<T>, class Growth = GrowDouble>
+class CowVector {
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    CowVector();
+    CowVector(int size);
+    CowVector(const Vector<T, Alloc, Growth>& r);
+    CowVector(const CowVector<T, Alloc, Growth>& r);
+    CowVector(CowVector<T, Alloc, Growth>&& r) noexcept;
+    ~CowVector();
+
+    CowVector<T, Alloc, Growth>& operator=(const CowVector<T, Alloc, Growth>& r);
+    CowVector<T, Alloc, Growth>& operator=(CowVector<T, Alloc, Growth>&& r) noexcept;
+
+    T& operator[](int index);
+    const T& operator[](int index) const;
+    T& at(int index);
+    const T& at(int index) const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    T* data();
+    const T* data() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    int size() const;
+    int capacity() const;
+    bool empty() const;
+    void push_back(const T& x);
+    void push_back(T&& x);
+    template<class... Args> T& emplace_back(Args&&... args);
+    void pop_back();
+    void clear();
+
+    void reserve(int new_capacity);
+    void resize(int new_size);
+    void resize(int new_size, const T& value);
+
+    void swap(CowVector<T, Alloc, Growth>& r) noexcept;
+
+    int use_count() const;
+
+private:
+    // The shared buffer: the elements and the number of CowVectors sharing them
+    struct Shared {
+        std::atomic<int> refs;
+        bool shareable;
+        Vector<T, Alloc, Growth> elements;
+
+        template<class... Args>
+        Shared(Args&&... args): refs(1), shareable(true), elements(std::forward<Args>(args)...) {}
+    };
+
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Shared> shared_allocator;
+    typedef std::allocator_traits<shared_allocator> shared_traits;
+
+    template<class... Args> static Shared* make_shared(Args&&... args);
+    static void unref(Shared *shared) noexcept;
+
+    static const Vector<T, Alloc, Growth>& empty_vector();
+
+    const Vector<T, Alloc, Growth>& view() const;
+    Vector<T, Alloc, Growth>& mutate();
+    Vector<T, Alloc, Growth>& leak();
+
+    Shared *m_pShared;  // The buffer, nullptr while the vector has never held anything
+};
+
+
+/*
+ * @brief Default constructor. Creates an empty vector; nothing is allocated.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::CowVector(): m_pShared(nullptr) {}
+
+/*
+ * @brief Creates a new vector with the given size. The elements are default-constructed.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::CowVector(int size): m_pShared(size > 0 ? make_shared(size) : nullptr) {}
+
+/*
+ * @brief Creates a vector with a copy of the elements of a Vector.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::CowVector(const Vector<T, Alloc, Growth>& r): m_pShared(r.empty() ? nullptr : make_shared(r)) {}
+
+/*
+ * @brief Copy constructor. Shares the buffer of r, unless r has handed out a mutable reference.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::CowVector(const CowVector<T, Alloc, Growth>& r): m_pShared(r.m_pShared) {
+    if (m_pShared == nullptr) {
+        return;
+    }
+    if (m_pShared->shareable) {
+        m_pShared->refs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m_pShared = make_shared(r.m_pShared->elements);
+    }
+}
+
+/*
+ * @brief Move constructor. Takes the buffer of r and leaves r empty.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::CowVector(CowVector<T, Alloc, Growth>&& r) noexcept: m_pShared(r.m_pShared) {
+    r.m_pShared = nullptr;
+}
+
+/*
+ * @brief Destructor. The buffer is freed by the last sharer.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>::~CowVector() {
+    unref(m_pShared);
+}
+
+/*
+ * @brief Copy assignment. Shares the buffer of r like the copy constructor.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::operator=(const CowVector<T, Alloc, Growth>& r) {
+    if (this != &r) {
+        CowVector<T, Alloc, Growth> copy(r);
+        swap(copy);
+    }
+    return *this;
+}
+
+/*
+ * @brief Move assignment. Takes the buffer of r and leaves r empty.
+ */
+template<class T, class Alloc, class Growth>
+CowVector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::operator=(CowVector<T, Alloc, Growth>&& r) noexcept {
+    if (this != &r) {
+        unref(m_pShared);
+        m_pShared = r.m_pShared;
+        r.m_pShared = nullptr;
+    }
+    return *this;
+}
+
+/*
+ * @brief Return the element at the given index for writing. Detaches a shared buffer.
+ * @param index The index of the element to return.
+ */
+template<class T, class Alloc, class Growth>
+T& CowVector<T, Alloc, Growth>::operator[](int index) {
+    return leak()[index];
+}
+
+/*
+ * @brief Return the element at the given index for reading. Never detaches.
+ * @param index The index of the element to return.
+ */
+template<class T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::operator[](int index) const {
+    return view()[index];
+}
+
+/*
+ * @brief Return the element at the given index for writing. If the index is out of range, throw an exception.
+ * @param index The index of the element to return.
+ */
+template<class T, class Alloc, class Growth>
+T& CowVector<T, Alloc, Growth>::at(int index) {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return leak()[index];
+}
+
+template<class T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::at(int index) const {
+    return view().at(index);
+}
+
+template<class T, class Alloc, class Growth>
+T& CowVector<T, Alloc, Growth>::front() {
+    return leak().front();
+}
+
+template<class T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::front() const {
+    return view().front();
+}
+
+template<class T, class Alloc, class Growth>
+T& CowVector<T, Alloc, Growth>::back() {
+    return leak().back();
+}
+
+template<class T, class Alloc, class Growth>
+const T& CowVector<T, Alloc, Growth>::back() const {
+    return view().back();
+}
+
+template<class T, class Alloc, class Growth>
+T* CowVector<T, Alloc, Growth>::data() {
+    return m_pShared == nullptr ? nullptr : leak().data();
+}
+
+template<class T, class Alloc, class Growth>
+const T* CowVector<T, Alloc, Growth>::data() const {
+    return view().data();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::iterator CowVector<T, Alloc, Growth>::begin() {
+    return data();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::iterator CowVector<T, Alloc, Growth>::end() {
+    return data() + size();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::const_iterator CowVector<T, Alloc, Growth>::begin() const {
+    return view().begin();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::const_iterator CowVector<T, Alloc, Growth>::end() const {
+    return view().end();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::const_iterator CowVector<T, Alloc, Growth>::cbegin() const {
+    return view().begin();
+}
+
+template<class T, class Alloc, class Growth>
+typename CowVector<T, Alloc, Growth>::const_iterator CowVector<T, Alloc, Growth>::cend() const {
+    return view().end();
+}
+
+/*
+ * @brief Return the number of elements in the vector.
+ */
+template<class T, class Alloc, class Growth>
+int CowVector<T, Alloc, Growth>::size() const {
+    return view().size();
+}
+
+/*
+ * @brief Return the capacity of the (possibly shared) buffer.
+ */
+template<class T, class Alloc, class Growth>
+int CowVector<T, Alloc, Growth>::capacity() const {
+    return view().capacity();
+}
+
+template<class T, class Alloc, class Growth>
+bool CowVector<T, Alloc, Growth>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief Add a copy of the element to the end of the vector. Detaches a shared buffer.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::push_back(const T& x) {
+    if (m_pShared != nullptr && m_pShared->refs.load(std::memory_order_acquire) > 1) {
+        T copy(x);  // x may live in the buffer we are about to let go
+        mutate().push_back(std::move(copy));
+    } else {
+        mutate().push_back(x);
+    }
+}
+
+/*
+ * @brief Move the element to the end of the vector. Detaches a shared buffer.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::push_back(T&& x) {
+    mutate().push_back(std::move(x));
+}
+
+/*
+ * @brief Construct a new element at the end of the vector from args. Detaches a shared buffer.
+ * @return A reference to the new element; the buffer becomes unshareable.
+ */
+template<class T, class Alloc, class Growth>
+template<class... Args>
+T& CowVector<T, Alloc, Growth>::emplace_back(Args&&... args) {
+    if (m_pShared != nullptr && m_pShared->refs.load(std::memory_order_acquire) > 1) {
+        T value(std::forward<Args>(args)...);  // args may refer to the buffer we are about to let go
+        leak().emplace_back(std::move(value));
+    } else {
+        leak().emplace_back(std::forward<Args>(args)...);
+    }
+    return m_pShared->elements.back();
+}
+
+/*
+ * @brief Remove the last element. The vector must not be empty. Detaches a shared buffer.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::pop_back() {
+    assert(size() > 0);
+    mutate().pop_back();
+}
+
+/*
+ * @brief Remove every element. A shared buffer is simply let go, nothing is copied.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::clear() {
+    if (m_pShared == nullptr) {
+        return;
+    }
+    if (m_pShared->refs.load(std::memory_order_acquire) > 1) {
+        unref(m_pShared);
+        m_pShared = nullptr;
+    } else {
+        m_pShared->elements.clear();
+        m_pShared->shareable = true;
+    }
+}
+
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::reserve(int new_capacity) {
+    if (new_capacity > capacity()) {
+        mutate().reserve(new_capacity);
+    }
+}
+
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::resize(int new_size) {
+    if (new_size != size()) {
+        mutate().resize(new_size);
+    }
+}
+
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::resize(int new_size, const T& value) {
+    if (new_size != size()) {
+        T copy(value);  // value may live in the buffer we are about to let go
+        mutate().resize(new_size, copy);
+    }
+}
+
+/*
+ * @brief Exchange the contents of the two vectors.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::swap(CowVector<T, Alloc, Growth>& r) noexcept {
+    std::swap(m_pShared, r.m_pShared);
+}
+
+/*
+ * @brief Return the number of CowVectors sharing this buffer (0 if there is no buffer).
+ */
+template<class T, class Alloc, class Growth>
+int CowVector<T, Alloc, Growth>::use_count() const {
+    return m_pShared == nullptr ? 0 : m_pShared->refs.load(std::memory_order_acquire);
+}
+
+template<class T, class Alloc, class Growth>
+template<class... Args>
+typename CowVector<T, Alloc, Growth>::Shared* CowVector<T, Alloc, Growth>::make_shared(Args&&... args) {
+    shared_allocator alloc;
+    Shared *shared = shared_traits::allocate(alloc, 1);
+    try {
+        shared_traits::construct(alloc, shared, std::forward<Args>(args)...);
+    } catch (...) {
+        shared_traits::deallocate(alloc, shared, 1);
+        throw;
+    }
+    return shared;
+}
+
+/*
+ * @brief Drop one reference to the buffer; the last one frees it.
+ */
+template<class T, class Alloc, class Growth>
+void CowVector<T, Alloc, Growth>::unref(Shared *shared) noexcept {
+    if (shared != nullptr && shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        shared_allocator alloc;
+        shared_traits::destroy(alloc, shared);
+        shared_traits::deallocate(alloc, shared, 1);
+    }
+}
+
+template<class T, class Alloc, class Growth>
+const Vector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::empty_vector() {
+    static const Vector<T, Alloc, Growth> empty;
+    return empty;
+}
+
+/*
+ * @brief Return the elements for reading.
+ */
+template<class T, class Alloc, class Growth>
+const Vector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::view() const {
+    return m_pShared == nullptr ? empty_vector() : m_pShared->elements;
+}
+
+/*
+ * @brief Return the elements for writing: the buffer is created if there is none, and copied
+ *        if it is shared (this is the only place where elements are copied).
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::mutate() {
+    if (m_pShared == nullptr) {
+        m_pShared = make_shared();
+    } else if (m_pShared->refs.load(std::memory_order_acquire) > 1) {
+        Shared *own = make_shared(m_pShared->elements);
+        unref(m_pShared);
+        m_pShared = own;
+    }
+    return m_pShared->elements;
+}
+
+/*
+ * @brief Like mutate(), for an access which hands out a mutable reference: the buffer
+ *        becomes unshareable, so later copies of this vector are deep copies.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& CowVector<T, Alloc, Growth>::leak() {
+    Vector<T, Alloc, Growth>& elements = mutate();
+    m_pShared->shareable = false;
+    return elements;
+}
@@ -0,0 +1,503 @@
+#pragma once
+#include "vector.h"
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Class template MappedVector
+ * A vector of trivially copyable elements whose storage is a memory-mapped file, so the
+ * contents survive the process and may be larger than RAM. The file starts with a one-page
+ * header (magic, element size, size, capacity) followed by the elements as they are in memory:
+ * opening an existing file is a single mmap() with no parse step, and the kernel only reads
+ * the pages that are touched.
+ * Growth extends the file with ftruncate() and the mapping with mremap(). Changes reach the
+ * file through the page cache; sync() forces them to disk with msync(). For random access
+ * to a file larger than RAM, call advise_random() so the kernel does not read ahead.
+ * Sizes and indices are long long, since a file may hold more than INT_MAX elements.
+ * A moved-from MappedVector may only be destroyed or assigned to.
+ */
+template<class T, class Growth = GrowDouble>
+class MappedVector {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector stores the raw bytes of its elements");
+    static_assert(alignof(T) <= 4096, "MappedVector elements are aligned to the page after the header");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    explicit MappedVector(const std::string& path);
+    MappedVector(const MappedVector<T, Growth>&) = delete;
+    MappedVector(MappedVector<T, Growth>&& r) noexcept;
+    ~MappedVector();
+
+    MappedVector<T, Growth>& operator=(const MappedVector<T, Growth>&) = delete;
+    MappedVector<T, Growth>& operator=(MappedVector<T, Growth>&& r) noexcept;
+
+    T& operator[](long long index);
+    const T& operator[](long long index) const;
+    T& at(long long index);
+    const T& at(long long index) const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    T* data();
+    const T* data() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    long long size() const;
+    long long capacity() const;
+    bool empty() const;
+    void push_back(const T& x);
+    template<class... Args> T& emplace_back(Args&&... args);
+    void pop_back();
+    void clear();
+
+    void reserve(long long new_capacity);
+    void resize(long long new_size);
+    void resize(long long new_size, const T& value);
+    void shrink_to_fit();
+
+    void sync();
+    void advise_random(bool random);
+    const std::string& path() const;
+
+private:
+    // The first page of the file
+    struct Header {
+        char magic[8];              // "MAPVEC1\0"
+        std::uint64_t element_size; // sizeof(T) when the file was created
+        std::int64_t size;          // The number of elements
+        std::int64_t capacity;      // The number of elements the file can hold
+    };
+
+    static constexpr std::size_t HEADER_BYTES = 4096;
+    static constexpr char MAGIC[8] = {'M', 'A', 'P', 'V', 'E', 'C', '1', '\0'};
+
+    static std::size_t file_bytes(long long capacity);
+    static void throw_errno(const char *what);
+
+    Header* header() const;
+    T* elements() const;
+    void remap(long long new_capacity);
+    void unmap() noexcept;
+
+    std::string m_strPath;      // The backing file
+    int m_fd;                   // The open file, -1 after a move
+    void *m_pMapping;           // The mapping of the whole file: header, then elements
+    std::size_t m_nMappedBytes; // The length of the mapping
+};
+
+
+/*
+ * @brief Open the vector stored in the file at path, or create an empty one if the file does
+ *        not exist. If the file is not a MappedVector of this element size, throw an exception.
+ */
+template<class T, class Growth>
+MappedVector<T, Growth>::MappedVector(const std::string& path): m_strPath(path), m_fd(-1), m_pMapping(nullptr), m_nMappedBytes(0) {
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+        throw_errno("open");
+    }
+    struct stat st;
+    if (::fstat(m_fd, &st) < 0) {
+        unmap();
+        throw_errno("fstat");
+    }
+
+    bool created = st.st_size == 0;
+    if (created && ::ftruncate(m_fd, static_cast<off_t>(HEADER_BYTES)) < 0) {
+        unmap();
+        throw_errno("ftruncate");
+    }
+    if (!created && static_cast<std::size_t>(st.st_size) < HEADER_BYTES) {
+        unmap();
+        throw std::runtime_error("Not a MappedVector file: " + path);
+    }
+
+    m_nMappedBytes = created ? HEADER_BYTES : static_cast<std::size_t>(st.st_size);
+    m_pMapping = ::mmap(nullptr, m_nMappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_pMapping == MAP_FAILED) {
+        m_pMapping = nullptr;
+        unmap();
+        throw_errno("mmap");
+    }
+
+    Header *h = header();
+    if (created) {
+        std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+        h->element_size = sizeof(T);
+        h->size = 0;
+        h->capacity = 0;
+    } else if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0 || h->element_size != sizeof(T) ||
+               0 > h->size || 0 > h->capacity || h->size > h->capacity ||
+               static_cast<std::uint64_t>(h->capacity) > (m_nMappedBytes - HEADER_BYTES) / sizeof(T)) {
+        // A corrupt size or capacity would put end() and back() outside the mapping
+        unmap();
+        throw std::runtime_error("Not a MappedVector file of this element type: " + path);
+    }
+}
+
+/*
+ * @brief Move constructor. Takes over the mapping of r.
+ */
+template<class T, class Growth>
+MappedVector<T, Growth>::MappedVector(MappedVector<T, Growth>&& r) noexcept
+    : m_strPath(std::move(r.m_strPath)), m_fd(r.m_fd), m_pMapping(r.m_pMapping), m_nMappedBytes(r.m_nMappedBytes) {
+    r.m_fd = -1;
+    r.m_pMapping = nullptr;
+    r.m_nMappedBytes = 0;
+}
+
+/*
+ * @brief Destructor. Unmaps and closes the file; the dirty pages are written back by the kernel.
+ */
+template<class T, class Growth>
+MappedVector<T, Growth>::~MappedVector() {
+    unmap();
+}
+
+/*
+ * @brief Move assignment. Closes the current file and takes over the mapping of r.
+ */
+template<class T, class Growth>
+MappedVector<T, Growth>& MappedVector<T, Growth>::operator=(MappedVector<T, Growth>&& r) noexcept {
+    if (this != &r) {
+        unmap();
+        m_strPath = std::move(r.m_strPath);
+        m_fd = r.m_fd;
+        m_pMapping = r.m_pMapping;
+        m_nMappedBytes = r.m_nMappedBytes;
+        r.m_fd = -1;
+        r.m_pMapping = nullptr;
+        r.m_nMappedBytes = 0;
+    }
+    return *this;
+}
+
+/*
+ * @brief Return the element at the given index.
+ * @param index The index of the element to return.
+ */
+template<class T, class Growth>
+T& MappedVector<T, Growth>::operator[](long long index) {
+    return elements()[index];
+}
+
+template<class T, class Growth>
+const T& MappedVector<T, Growth>::operator[](long long index) const {
+    return elements()[index];
+}
+
+/*
+ * @brief Return the element at the given index. If the index is out of range, throw an exception.
+ * @param index The index of the element to return.
+ */
+template<class T, class Growth>
+T& MappedVector<T, Growth>::at(long long index) {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return elements()[index];
+}
+
+template<class T, class Growth>
+const T& MappedVector<T, Growth>::at(long long index) const {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return elements()[index];
+}
+
+/*
+ * @brief Return the first element. The vector must not be empty.
+ */
+template<class T, class Growth>
+T& MappedVector<T, Growth>::front() {
+    assert(size() > 0);
+    return elements()[0];
+}
+
+template<class T, class Growth>
+const T& MappedVector<T, Growth>::front() const {
+    assert(size() > 0);
+    return elements()[0];
+}
+
+/*
+ * @brief Return the last element. The vector must not be empty.
+ */
+template<class T, class Growth>
+T& MappedVector<T, Growth>::back() {
+    assert(size() > 0);
+    return elements()[size() - 1];
+}
+
+template<class T, class Growth>
+const T& MappedVector<T, Growth>::back() const {
+    assert(size() > 0);
+    return elements()[size() - 1];
+}
+
+/*
+ * @brief Return the pointer to the first element. It changes when the vector grows.
+ */
+template<class T, class Growth>
+T* MappedVector<T, Growth>::data() {
+    return elements();
+}
+
+template<class T, class Growth>
+const T* MappedVector<T, Growth>::data() const {
+    return elements();
+}
+
+template<class T, class Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::begin() {
+    return elements();
+}
+
+template<class T, class Growth>
+typename MappedVector<T, Growth>::iterator MappedVector<T, Growth>::end() {
+    return elements() + size();
+}
+
+template<class T, class Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::begin() const {
+    return elements();
+}
+
+template<class T, class Growth>
+typename MappedVector<T, Growth>::const_iterator MappedVector<T, Growth>::end() const {
+    return elements() + size();
+}
+
+/*
+ * @brief Return the number of elements in the vector.
+ */
+template<class T, class Growth>
+long long MappedVector<T, Growth>::size() const {
+    return header()->size;
+}
+
+/*
+ * @brief Return the number of elements the file can hold without growing.
+ */
+template<class T, class Growth>
+long long MappedVector<T, Growth>::capacity() const {
+    return header()->capacity;
+}
+
+/*
+ * @brief Return true if the vector is empty.
+ */
+template<class T, class Growth>
+bool MappedVector<T, Growth>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief Add a copy of the element to the end of the vector.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::push_back(const T& x) {
+    emplace_back(x);
+}
+
+/*
+ * @brief Construct a new element at the end of the vector from args.
+ *        The new value is built before the file grows, so args may refer to an element.
+ * @return A reference to the new element.
+ */
+template<class T, class Growth>
+template<class... Args>
+T& MappedVector<T, Growth>::emplace_back(Args&&... args) {
+    if (size() == capacity()) {
+        T value(std::forward<Args>(args)...);
+        // Grow by at least one page, a smaller file would be remapped at every push_back
+        remap(std::max<long long>(Growth::next_capacity(capacity()), HEADER_BYTES / sizeof(T)));
+        T *p = elements() + size();
+        std::memcpy(static_cast<void*>(p), static_cast<const void*>(&value), sizeof(T));
+        header()->size++;
+        return *p;
+    }
+    T *p = ::new (static_cast<void*>(elements() + size())) T(std::forward<Args>(args)...);
+    header()->size++;
+    return *p;
+}
+
+/*
+ * @brief Remove the last element. The vector must not be empty.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::pop_back() {
+    assert(size() > 0);
+    header()->size--;
+}
+
+/*
+ * @brief Remove every element. The file keeps its capacity.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::clear() {
+    header()->size = 0;
+}
+
+/*
+ * @brief Grow the file so that it holds new_capacity elements.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::reserve(long long new_capacity) {
+    if (new_capacity > capacity()) {
+        remap(new_capacity);
+    }
+}
+
+/*
+ * @brief Change the size of the vector. New elements are value-initialized.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::resize(long long new_size) {
+    resize(new_size, T());
+}
+
+/*
+ * @brief Change the size of the vector. New elements are copies of value.
+ *        A negative size throws std::length_error.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::resize(long long new_size, const T& value) {
+    if (new_size < 0) {
+        throw std::length_error("MappedVector size cannot be negative");
+    }
+    if (new_size > capacity()) {
+        T copy(value);  // value may live in the mapping, which is about to move
+        remap(new_size);
+        std::fill(elements() + size(), elements() + new_size, copy);
+    } else if (new_size > size()) {
+        std::fill(elements() + size(), elements() + new_size, value);
+    }
+    header()->size = new_size;
+}
+
+/*
+ * @brief Truncate the file to the live elements.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::shrink_to_fit() {
+    if (capacity() > size()) {
+        remap(size());
+    }
+}
+
+/*
+ * @brief Write the dirty pages and the header to disk, and wait until they are written.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::sync() {
+    if (::msync(m_pMapping, m_nMappedBytes, MS_SYNC) < 0) {
+        throw_errno("msync");
+    }
+}
+
+/*
+ * @brief Tell the kernel whether the elements will be read in random order. With random
+ *        access, a page fault reads only the page touched instead of a readahead window.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::advise_random(bool random) {
+    if (::madvise(m_pMapping, m_nMappedBytes, random ? MADV_RANDOM : MADV_NORMAL) < 0) {
+        throw_errno("madvise");
+    }
+}
+
+/*
+ * @brief Return the path of the backing file.
+ */
+template<class T, class Growth>
+const std::string& MappedVector<T, Growth>::path() const {
+    return m_strPath;
+}
+
+template<class T, class Growth>
+std::size_t MappedVector<T, Growth>::file_bytes(long long capacity) {
+    return HEADER_BYTES + static_cast<std::size_t>(capacity) * sizeof(T);
+}
+
+template<class T, class Growth>
+void MappedVector<T, Growth>::throw_errno(const char *what) {
+    throw std::system_error(errno, std::generic_category(), std::string("MappedVector: ") + what);
+}
+
+template<class T, class Growth>
+typename MappedVector<T, Growth>::Header* MappedVector<T, Growth>::header() const {
+    return static_cast<Header*>(m_pMapping);
+}
+
+template<class T, class Growth>
+T* MappedVector<T, Growth>::elements() const {
+    return reinterpret_cast<T*>(static_cast<char*>(m_pMapping) + HEADER_BYTES);
+}
+
+/*
+ * @brief Resize the file to new_capacity elements and the mapping with it. mremap() keeps the
+ *        physical pages, so nothing is copied even if the mapping moves. If the file cannot grow,
+ *        the vector is unchanged.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::remap(long long new_capacity) {
+    std::size_t new_bytes = file_bytes(new_capacity);
+    bool shrinking = new_bytes < m_nMappedBytes;
+    if (!shrinking && ::ftruncate(m_fd, static_cast<off_t>(new_bytes)) < 0) {
+        throw_errno("ftruncate");
+    }
+#if defined(__linux__)
+    void *p = ::mremap(m_pMapping, m_nMappedBytes, new_bytes, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) {
+        throw_errno("mremap");
+    }
+#else
+    void *p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (p == MAP_FAILED) {
+        throw_errno("mmap");
+    }
+    ::munmap(m_pMapping, m_nMappedBytes);
+#endif
+    m_pMapping = p;
+    m_nMappedBytes = new_bytes;
+    header()->capacity = new_capacity;
+    // The file is cut only after the mapping, which no longer covers the dropped pages
+    if (shrinking && ::ftruncate(m_fd, static_cast<off_t>(new_bytes)) < 0) {
+        throw_errno("ftruncate");
+    }
+}
+
+/*
+ * @brief Unmap the file and close it.
+ */
+template<class T, class Growth>
+void MappedVector<T, Growth>::unmap() noexcept {
+    int saved_errno = errno;    // Keep the error which made the constructor give up
+    if (m_pMapping != nullptr) {
+        ::munmap(m_pMapping, m_nMappedBytes);
+        m_pMapping = nullptr;
+        m_nMappedBytes = 0;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    errno = saved_errno;
+}
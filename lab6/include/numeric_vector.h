@@ -0,0 +1,149 @@
+#pragma once
+#include "vector.h"
+#include "aligned_allocator.h"
+#include "simd.h"
+
+/*
+ * Growth policy GrowPadded<Lanes>
+ * Doubles the capacity like GrowDouble, then rounds it up to a multiple of Lanes, so the buffer
+ * always holds a whole number of SIMD vectors.
+ */
+template<int Lanes>
+struct GrowPadded {
+    static_assert(Lanes > 0, "GrowPadded needs a positive lane count");
+
+    static long long next_capacity(long long capacity) {
+        long long doubled = GrowDouble::next_capacity(capacity);
+        return (doubled + Lanes - 1) / Lanes * Lanes;
+    }
+};
+
+/*
+ * Class template NumericVector
+ * A Vector of numbers whose storage starts on an Align-byte boundary (64 by default: one cache
+ * line, one AVX-512 vector, two AVX2 vectors) and whose capacity is padded to whole vectors.
+ * The bulk operations run the SIMD kernels of simd.h, picked at run time for this CPU.
+ */
+template<class T, std::size_t Align = 64>
+class NumericVector : public Vector<T, AlignedAllocator<T, Align>, GrowPadded<static_cast<int>(Align / sizeof(T))>> {
+    static_assert(std::is_arithmetic<T>::value, "NumericVector holds numbers only");
+
+    typedef Vector<T, AlignedAllocator<T, Align>, GrowPadded<static_cast<int>(Align / sizeof(T))>> base_type;
+
+public:
+    static constexpr int lanes = static_cast<int>(Align / sizeof(T));
+
+    using base_type::base_type;
+    NumericVector() = default;
+
+    void reserve(int new_capacity);
+
+    void fill(T value);
+    simd::sum_t<T> sum() const;
+    T min() const;
+    T max() const;
+    simd::sum_t<T> dot(const NumericVector<T, Align>& r) const;
+    void axpy(T a, const NumericVector<T, Align>& x);
+    template<class F> void transform(F f);
+    int compare(const NumericVector<T, Align>& r) const;
+
+    bool operator==(const NumericVector<T, Align>& r) const;
+    bool operator!=(const NumericVector<T, Align>& r) const;
+};
+
+
+/*
+ * @brief Make room for at least new_capacity elements, rounded up to a whole number of vectors.
+ */
+template<class T, std::size_t Align>
+void NumericVector<T, Align>::reserve(int new_capacity) {
+    long long padded = (static_cast<long long>(new_capacity) + lanes - 1) / lanes * lanes;
+    base_type::reserve(static_cast<int>(std::min<long long>(padded, INT_MAX)));
+}
+
+/*
+ * @brief Set every element to value.
+ */
+template<class T, std::size_t Align>
+void NumericVector<T, Align>::fill(T value) {
+    simd::fill(this->data(), this->size(), value);
+}
+
+/*
+ * @brief Return the sum of the elements (in 64 bits for integers).
+ */
+template<class T, std::size_t Align>
+simd::sum_t<T> NumericVector<T, Align>::sum() const {
+    return simd::sum(this->data(), this->size());
+}
+
+/*
+ * @brief Return the smallest element. The vector must not be empty.
+ */
+template<class T, std::size_t Align>
+T NumericVector<T, Align>::min() const {
+    return simd::min(this->data(), this->size());
+}
+
+/*
+ * @brief Return the largest element. The vector must not be empty.
+ */
+template<class T, std::size_t Align>
+T NumericVector<T, Align>::max() const {
+    return simd::max(this->data(), this->size());
+}
+
+/*
+ * @brief Return the dot product with r. If the sizes differ, throw an exception.
+ */
+template<class T, std::size_t Align>
+simd::sum_t<T> NumericVector<T, Align>::dot(const NumericVector<T, Align>& r) const {
+    if (this->size() != r.size()) {
+        throw std::invalid_argument("Vector sizes do not match");
+    }
+    return simd::dot(this->data(), r.data(), this->size());
+}
+
+/*
+ * @brief Add a * x to this vector, element by element. If the sizes differ, throw an exception.
+ */
+template<class T, std::size_t Align>
+void NumericVector<T, Align>::axpy(T a, const NumericVector<T, Align>& x) {
+    if (this->size() != x.size()) {
+        throw std::invalid_argument("Vector sizes do not match");
+    }
+    simd::axpy(a, x.data(), this->data(), this->size());
+}
+
+/*
+ * @brief Replace every element x by f(x).
+ */
+template<class T, std::size_t Align>
+template<class F>
+void NumericVector<T, Align>::transform(F f) {
+    simd::transform(this->data(), this->data(), this->size(), f);
+}
+
+/*
+ * @brief Compare with r lexicographically.
+ * @return A negative number if this vector is less than r, 0 if they are equal, a positive number otherwise.
+ */
+template<class T, std::size_t Align>
+int NumericVector<T, Align>::compare(const NumericVector<T, Align>& r) const {
+    int n = std::min(this->size(), r.size());
+    int i = simd::mismatch(this->data(), r.data(), n);
+    if (i < n) {
+        return (*this)[i] < r[i] ? -1 : 1;
+    }
+    return this->size() < r.size() ? -1 : (this->size() > r.size() ? 1 : 0);
+}
+
+template<class T, std::size_t Align>
+bool NumericVector<T, Align>::operator==(const NumericVector<T, Align>& r) const {
+    return this->size() == r.size() && compare(r) == 0;
+}
+
+template<class T, std::size_t Align>
+bool NumericVector<T, Align>::operator!=(const NumericVector<T, Align>& r) const {
+    return !(*this == r);
+}
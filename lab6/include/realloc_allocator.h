@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/*
+ * Class template ReallocAllocator
+ * A malloc()-based allocator providing the two growth extensions understood by Vector:
+ * expand_in_place() succeeds when the block already has enough usable space, and
+ * reallocate() forwards to realloc(), which can grow large blocks by remapping pages
+ * instead of copying them.
+ */
+template<class T>
+class ReallocAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    template<class U>
+    struct rebind {
+        typedef ReallocAllocator<U> other;
+    };
+
+    ReallocAllocator() noexcept = default;
+    template<class U> ReallocAllocator(const ReallocAllocator<U>&) noexcept {}
+
+    /*
+     * @brief Allocate raw memory for n objects of type T.
+     */
+    T* allocate(size_type n) {
+        void *p = std::malloc(n * sizeof(T));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    /*
+     * @brief Free the memory at p.
+     */
+    void deallocate(T *p, size_type) noexcept {
+        std::free(p);
+    }
+
+    /*
+     * @brief Grow the block at p from old_n to new_n objects without moving it.
+     * @return true if the block is already large enough, false otherwise.
+     */
+    bool expand_in_place(T *p, size_type old_n, size_type new_n) noexcept {
+#if defined(__GLIBC__)
+        return malloc_usable_size(p) >= new_n * sizeof(T);
+#else
+        return false;
+#endif
+    }
+
+    /*
+     * @brief Grow the block at p from old_n to new_n objects with realloc().
+     *        The bytes are moved if the block cannot grow in place, so T must be trivially relocatable.
+     */
+    T* reallocate(T *p, size_type old_n, size_type new_n) {
+        void *new_p = std::realloc(static_cast<void*>(p), new_n * sizeof(T));
+        if (new_p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(new_p);
+    }
+
+    bool operator==(const ReallocAllocator&) const noexcept { return true; }
+    bool operator!=(const ReallocAllocator&) const noexcept { return false; }
+};
@@ -0,0 +1,587 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+/*
+ * Bulk numeric kernels used by NumericVector.
+ * Every kernel has a portable scalar version; on x86 there are hand-written AVX2(+FMA) kernels
+ * for double and int, and SSE2 kernels for double. The kernel is picked at run time from the
+ * CPU features (see active_isa()), so the program is still built for the baseline ISA.
+ * The vector kernels use several accumulators, so floating-point sums may differ from the
+ * scalar result in the last bits.
+ */
+namespace simd {
+
+enum class isa { scalar, sse2, avx2 };
+
+/*
+ * @brief Return the best instruction set supported by this CPU.
+ */
+inline isa detect_isa() {
+#if SIMD_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+inline isa& active_isa_ref() {
+    static isa active = detect_isa();
+    return active;
+}
+
+/*
+ * @brief Return the instruction set the kernels dispatch to.
+ */
+inline isa active_isa() {
+    return active_isa_ref();
+}
+
+/*
+ * @brief Force the kernels to the given instruction set (used by the benchmarks and tests).
+ *        A set the CPU does not support is lowered to the best supported one.
+ */
+inline void set_isa(isa target) {
+    active_isa_ref() = std::min(target, detect_isa());
+}
+
+inline const char* isa_name(isa target) {
+    switch (target) {
+        case isa::avx2: return "avx2";
+        case isa::sse2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+// The type of a sum or dot product: integers are widened to 64 bits
+template<class T>
+using sum_t = std::conditional_t<std::is_integral<T>::value, long long, T>;
+
+namespace scalar {
+
+template<class T>
+void fill(T *p, int n, T value) {
+    for (int i = 0; i < n; i++) {
+        p[i] = value;
+    }
+}
+
+template<class T>
+sum_t<T> sum(const T *p, int n) {
+    sum_t<T> s = 0;
+    for (int i = 0; i < n; i++) {
+        s += p[i];
+    }
+    return s;
+}
+
+template<class T>
+T min(const T *p, int n) {
+    T m = p[0];
+    for (int i = 1; i < n; i++) {
+        m = p[i] < m ? p[i] : m;
+    }
+    return m;
+}
+
+template<class T>
+T max(const T *p, int n) {
+    T m = p[0];
+    for (int i = 1; i < n; i++) {
+        m = p[i] > m ? p[i] : m;
+    }
+    return m;
+}
+
+template<class T>
+sum_t<T> dot(const T *x, const T *y, int n) {
+    sum_t<T> s = 0;
+    for (int i = 0; i < n; i++) {
+        s += static_cast<sum_t<T>>(x[i]) * y[i];
+    }
+    return s;
+}
+
+// y = a * x + y; integer overflow wraps around
+template<class T>
+void axpy(T a, const T *x, T *y, int n) {
+    if constexpr (std::is_integral<T>::value) {
+        typedef std::make_unsigned_t<T> U;
+        for (int i = 0; i < n; i++) {
+            y[i] = static_cast<T>(static_cast<U>(y[i]) + static_cast<U>(a) * static_cast<U>(x[i]));
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            y[i] = a * x[i] + y[i];
+        }
+    }
+}
+
+// Index of the first i with x[i] != y[i], or n
+template<class T>
+int mismatch(const T *x, const T *y, int n) {
+    int i = 0;
+    while (i < n && x[i] == y[i]) {
+        i++;
+    }
+    return i;
+}
+
+template<class T, class F>
+void transform(const T *x, T *y, int n, F f) {
+    for (int i = 0; i < n; i++) {
+        y[i] = f(x[i]);
+    }
+}
+
+} // namespace scalar
+
+#if SIMD_X86
+namespace sse2 {
+
+__attribute__((target("sse2"))) inline void fill(double *p, int n, double value) {
+    __m128d v = _mm_set1_pd(value);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(p + i, v);
+    }
+    scalar::fill(p + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline double sum(const double *p, int n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_loadu_pd(p + i));
+        s1 = _mm_add_pd(s1, _mm_loadu_pd(p + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(s0, s1));
+    return lanes[0] + lanes[1] + scalar::sum(p + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline double min(const double *p, int n) {
+    if (n < 2) {
+        return scalar::min(p, n);
+    }
+    __m128d m = _mm_loadu_pd(p);
+    int i = 2;
+    for (; i + 2 <= n; i += 2) {
+        m = _mm_min_pd(m, _mm_loadu_pd(p + i));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, m);
+    double r = std::min(lanes[0], lanes[1]);
+    return i < n ? std::min(r, p[i]) : r;
+}
+
+__attribute__((target("sse2"))) inline double max(const double *p, int n) {
+    if (n < 2) {
+        return scalar::max(p, n);
+    }
+    __m128d m = _mm_loadu_pd(p);
+    int i = 2;
+    for (; i + 2 <= n; i += 2) {
+        m = _mm_max_pd(m, _mm_loadu_pd(p + i));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, m);
+    double r = std::max(lanes[0], lanes[1]);
+    return i < n ? std::max(r, p[i]) : r;
+}
+
+__attribute__((target("sse2"))) inline double dot(const double *x, const double *y, int n) {
+    __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(s0, s1));
+    return lanes[0] + lanes[1] + scalar::dot(x + i, y + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline void axpy(double a, const double *x, double *y, int n) {
+    __m128d va = _mm_set1_pd(a);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_mul_pd(va, _mm_loadu_pd(x + i)), _mm_loadu_pd(y + i)));
+    }
+    scalar::axpy(a, x + i, y + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline int mismatch(const double *x, const double *y, int n) {
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i))) != 0x3) {
+            break;
+        }
+    }
+    return i + scalar::mismatch(x + i, y + i, n - i);
+}
+
+} // namespace sse2
+
+namespace avx2 {
+
+__attribute__((target("avx2,fma"))) inline void fill(double *p, int n, double value) {
+    __m256d v = _mm256_set1_pd(value);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(p + i, v);
+    }
+    scalar::fill(p + i, n - i, value);
+}
+
+__attribute__((target("avx2,fma"))) inline void fill(int *p, int n, int value) {
+    __m256i v = _mm256_set1_epi32(value);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), v);
+    }
+    scalar::fill(p + i, n - i, value);
+}
+
+__attribute__((target("avx2,fma"))) inline double sum(const double *p, int n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(p + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(p + i + 4));
+        s2 = _mm256_add_pd(s2, _mm256_loadu_pd(p + i + 8));
+        s3 = _mm256_add_pd(s3, _mm256_loadu_pd(p + i + 12));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + scalar::sum(p + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline long long sum(const int *p, int n) {
+    __m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        s0 = _mm256_add_epi64(s0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        s1 = _mm256_add_epi64(s1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(s0, s1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sum(p + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline double min(const double *p, int n) {
+    if (n < 4) {
+        return scalar::min(p, n);
+    }
+    __m256d m = _mm256_loadu_pd(p);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm256_min_pd(m, _mm256_loadu_pd(p + i));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, m);
+    double r = scalar::min(lanes, 4);
+    return i < n ? std::min(r, scalar::min(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2,fma"))) inline int min(const int *p, int n) {
+    if (n < 8) {
+        return scalar::min(p, n);
+    }
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_min_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int r = scalar::min(lanes, 8);
+    return i < n ? std::min(r, scalar::min(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2,fma"))) inline double max(const double *p, int n) {
+    if (n < 4) {
+        return scalar::max(p, n);
+    }
+    __m256d m = _mm256_loadu_pd(p);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        m = _mm256_max_pd(m, _mm256_loadu_pd(p + i));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, m);
+    double r = scalar::max(lanes, 4);
+    return i < n ? std::max(r, scalar::max(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2,fma"))) inline int max(const int *p, int n) {
+    if (n < 8) {
+        return scalar::max(p, n);
+    }
+    __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    int i = 8;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int r = scalar::max(lanes, 8);
+    return i < n ? std::max(r, scalar::max(p + i, n - i)) : r;
+}
+
+__attribute__((target("avx2,fma"))) inline double dot(const double *x, const double *y, int n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(s0, s1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + scalar::dot(x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline long long dot(const int *x, const int *y, int n) {
+    __m256i s = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        // _mm256_mul_epi32 multiplies the even lanes into 64-bit products; shift to get the odd ones
+        s = _mm256_add_epi64(s, _mm256_mul_epi32(a, b));
+        s = _mm256_add_epi64(s, _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::dot(x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline void axpy(double a, const double *x, double *y, int n) {
+    __m256d va = _mm256_set1_pd(a);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    }
+    scalar::axpy(a, x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline void axpy(int a, const int *x, int *y, int n) {
+    __m256i va = _mm256_set1_epi32(a);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        __m256i vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), _mm256_add_epi32(_mm256_mullo_epi32(va, vx), vy));
+    }
+    scalar::axpy(a, x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline int mismatch(const double *x, const double *y, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), _CMP_EQ_OQ)) != 0xf) {
+            break;
+        }
+    }
+    return i + scalar::mismatch(x + i, y + i, n - i);
+}
+
+__attribute__((target("avx2,fma"))) inline int mismatch(const int *x, const int *y, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+        if (_mm256_movemask_epi8(eq) != -1) {
+            break;
+        }
+    }
+    return i + scalar::mismatch(x + i, y + i, n - i);
+}
+
+// The element-wise function is inlined here, so the compiler may vectorize it for AVX2
+template<class T, class F>
+__attribute__((target("avx2,fma"))) void transform(const T *x, T *y, int n, F f) {
+    for (int i = 0; i < n; i++) {
+        y[i] = f(x[i]);
+    }
+}
+
+} // namespace avx2
+#endif
+
+// Which element types have hand-written kernels
+template<class T>
+constexpr bool has_avx2_kernels = std::is_same<T, double>::value || std::is_same<T, int>::value;
+
+template<class T>
+constexpr bool has_sse2_kernels = std::is_same<T, double>::value;
+
+/*
+ * @brief Set p[0..n) to value.
+ */
+template<class T>
+void fill(T *p, int n, T value) {
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::fill(p, n, value);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::fill(p, n, value);
+        }
+    }
+#endif
+    scalar::fill(p, n, value);
+}
+
+/*
+ * @brief Return the sum of p[0..n). Integers are summed in 64 bits.
+ */
+template<class T>
+sum_t<T> sum(const T *p, int n) {
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::sum(p, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::sum(p, n);
+        }
+    }
+#endif
+    return scalar::sum(p, n);
+}
+
+/*
+ * @brief Return the smallest of p[0..n). n must be positive.
+ */
+template<class T>
+T min(const T *p, int n) {
+    assert(n > 0);
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::min(p, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::min(p, n);
+        }
+    }
+#endif
+    return scalar::min(p, n);
+}
+
+/*
+ * @brief Return the largest of p[0..n). n must be positive.
+ */
+template<class T>
+T max(const T *p, int n) {
+    assert(n > 0);
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::max(p, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::max(p, n);
+        }
+    }
+#endif
+    return scalar::max(p, n);
+}
+
+/*
+ * @brief Return the dot product of x[0..n) and y[0..n). Integers are multiplied and summed in 64 bits.
+ */
+template<class T>
+sum_t<T> dot(const T *x, const T *y, int n) {
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::dot(x, y, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::dot(x, y, n);
+        }
+    }
+#endif
+    return scalar::dot(x, y, n);
+}
+
+/*
+ * @brief Compute y = a * x + y over [0, n).
+ */
+template<class T>
+void axpy(T a, const T *x, T *y, int n) {
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::axpy(a, x, y, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::axpy(a, x, y, n);
+        }
+    }
+#endif
+    scalar::axpy(a, x, y, n);
+}
+
+/*
+ * @brief Return the index of the first element where x and y differ, or n if they are equal.
+ */
+template<class T>
+int mismatch(const T *x, const T *y, int n) {
+#if SIMD_X86
+    if constexpr (has_avx2_kernels<T>) {
+        if (active_isa() == isa::avx2) {
+            return avx2::mismatch(x, y, n);
+        }
+    }
+    if constexpr (has_sse2_kernels<T>) {
+        if (active_isa() >= isa::sse2) {
+            return sse2::mismatch(x, y, n);
+        }
+    }
+#endif
+    return scalar::mismatch(x, y, n);
+}
+
+/*
+ * @brief Compute y[i] = f(x[i]) over [0, n). x and y may be the same array.
+ */
+template<class T, class F>
+void transform(const T *x, T *y, int n, F f) {
+#if SIMD_X86
+    if (active_isa() == isa::avx2) {
+        return avx2::transform(x, y, n, f);
+    }
+#endif
+    scalar::transform(x, y, n, f);
+}
+
+} // namespace simd
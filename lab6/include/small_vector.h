@@ -0,0 +1,94 @@
+#pragma once
+#include "vector.h"
+
+/*
+ * Class template SmallVector
+ * A Vector which stores up to N elements in an inline buffer inside the object, and only goes
+ * to the heap when the buffer overflows. Growth, relocation and all the other operations are
+ * inherited from Vector, so a SmallVector can be passed wherever a Vector& is expected.
+ * Moving a SmallVector whose elements are inline cannot hand over a buffer: each element is moved
+ * (or copied, if T cannot be moved), and moving into a plain Vector also allocates, so these
+ * moves can throw. They are noexcept only when neither can happen.
+ */
+template<class T, int N, class Alloc = std::allocator<T>, class Growth = GrowDouble>
+class SmallVector : public Vector<T, Alloc, Growth> {
+    static_assert(N > 0, "SmallVector needs a non-empty inline buffer");
+
+    // Between two SmallVectors of the same N the inline elements always fit, so a move only
+    // throws if T's move does, or if unequal allocators force the heap elements to be moved
+    static constexpr bool nothrow_move = std::is_nothrow_move_constructible<T>::value &&
+        (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+         std::allocator_traits<Alloc>::is_always_equal::value);
+
+public:
+    SmallVector();
+    SmallVector(const SmallVector<T, N, Alloc, Growth>& r);
+    SmallVector(const Vector<T, Alloc, Growth>& r);
+    SmallVector(SmallVector<T, N, Alloc, Growth>&& r) noexcept(nothrow_move);
+
+    SmallVector<T, N, Alloc, Growth>& operator=(const SmallVector<T, N, Alloc, Growth>& r);
+    SmallVector<T, N, Alloc, Growth>& operator=(SmallVector<T, N, Alloc, Growth>&& r) noexcept(nothrow_move);
+
+    bool is_small() const;
+
+private:
+    alignas(T) unsigned char m_storage[N * sizeof(T)];   // The inline buffer, must directly follow the Vector subobject
+};
+
+
+/*
+ * @brief Default constructor. Creates an empty vector using the inline buffer.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(): Vector<T, Alloc, Growth>(reinterpret_cast<T*>(m_storage), N) {}
+
+/*
+ * @brief Copy constructor. The copy stays inline if r has at most N elements.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(const SmallVector<T, N, Alloc, Growth>& r): SmallVector() {
+    Vector<T, Alloc, Growth>::operator=(r);
+}
+
+/*
+ * @brief Creates a SmallVector with the same elements as a Vector.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(const Vector<T, Alloc, Growth>& r): SmallVector() {
+    Vector<T, Alloc, Growth>::operator=(r);
+}
+
+/*
+ * @brief Move constructor. A heap buffer is stolen, inline elements are moved one by one into
+ *        our inline buffer.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>::SmallVector(SmallVector<T, N, Alloc, Growth>&& r) noexcept(nothrow_move): SmallVector() {
+    Vector<T, Alloc, Growth>::operator=(std::move(r));
+}
+
+/*
+ * @brief Copy assignment.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>& SmallVector<T, N, Alloc, Growth>::operator=(const SmallVector<T, N, Alloc, Growth>& r) {
+    Vector<T, Alloc, Growth>::operator=(r);
+    return *this;
+}
+
+/*
+ * @brief Move assignment.
+ */
+template<class T, int N, class Alloc, class Growth>
+SmallVector<T, N, Alloc, Growth>& SmallVector<T, N, Alloc, Growth>::operator=(SmallVector<T, N, Alloc, Growth>&& r) noexcept(nothrow_move) {
+    Vector<T, Alloc, Growth>::operator=(std::move(r));
+    return *this;
+}
+
+/*
+ * @brief Return true if the elements are still stored in the inline buffer.
+ */
+template<class T, int N, class Alloc, class Growth>
+bool SmallVector<T, N, Alloc, Growth>::is_small() const {
+    return this->is_inline();
+}
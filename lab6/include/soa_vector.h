@@ -0,0 +1,356 @@
+#pragma once
+#include "vector.h"
+#include <tuple>
+
+/*
+ * Class template Span
+ * A view of count contiguous elements, used to hand out one column of a SoAVector.
+ */
+template<class T>
+class Span {
+public:
+    typedef T value_type;
+    typedef T* iterator;
+
+    Span(): m_pData(nullptr), m_nSize(0) {}
+    Span(T *data, int size): m_pData(data), m_nSize(size) {}
+
+    T& operator[](int index) const { return m_pData[index]; }
+    T* data() const { return m_pData; }
+    int size() const { return m_nSize; }
+    bool empty() const { return m_nSize == 0; }
+    T* begin() const { return m_pData; }
+    T* end() const { return m_pData + m_nSize; }
+
+private:
+    T *m_pData;     // The first element
+    int m_nSize;    // The number of elements
+};
+
+/*
+ * Class template SoAVector
+ * A vector of records stored as a structure of arrays: field I of every record lives in its
+ * own contiguous Vector, so a scan over one field only touches that field's memory, and a
+ * numeric column can be passed to the SIMD kernels as it is (see column()).
+ * All the columns have the same length. Before a record that needs more room is added, every
+ * column is reserved to the same new capacity, so a field whose construction throws cannot
+ * leave the columns with different capacities. operator[] returns a proxy for one row, whose
+ * get<I>() reaches its fields.
+ */
+template<class... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    template<bool IsConst> class basic_row;
+
+public:
+    typedef std::tuple<Fields...> value_type;
+    typedef basic_row<false> row;
+    typedef basic_row<true> const_row;
+
+    template<std::size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+    row operator[](int index);
+    const_row operator[](int index) const;
+    row at(int index);
+    const_row at(int index) const;
+    row back();
+    const_row back() const;
+
+    template<std::size_t I> Span<field_type<I>> column();
+    template<std::size_t I> Span<const field_type<I>> column() const;
+
+    int size() const;
+    int capacity() const;
+    bool empty() const;
+    void push_back(const value_type& x);
+    void push_back(value_type&& x);
+    template<class... Args> void emplace_back(Args&&... args);
+    void pop_back();
+    void clear();
+
+    void reserve(int new_capacity);
+    void shrink_to_fit();
+
+    void swap(SoAVector<Fields...>& r) noexcept;
+
+private:
+    typedef std::index_sequence_for<Fields...> indices;
+
+    int next_capacity() const;
+    // Kept out of line so that the fast path of emplace_back() stays small enough to inline
+    template<class... Args> __attribute__((noinline)) void grow_and_emplace_back(Args&&... args);
+    template<class... Args, std::size_t... I> void emplace_back_impl(std::index_sequence<I...>, Args&&... args);
+    template<std::size_t... I> void pop_columns(std::index_sequence<I...>, std::size_t count);
+
+    std::tuple<Vector<Fields>...> m_columns;    // One Vector per field
+};
+
+
+/*
+ * Class template SoAVector::basic_row
+ * A proxy for one record: it holds the vector and the index, and reaches the fields through
+ * get<I>(). It converts to a std::tuple of the field values, and a tuple can be assigned to it.
+ */
+template<class... Fields>
+template<bool IsConst>
+class SoAVector<Fields...>::basic_row {
+    typedef std::conditional_t<IsConst, const SoAVector<Fields...>, SoAVector<Fields...>> container_type;
+
+public:
+    basic_row(container_type *container, int index): m_pContainer(container), m_nIndex(index) {}
+
+    template<std::size_t I>
+    std::conditional_t<IsConst, const field_type<I>&, field_type<I>&> get() const {
+        return std::get<I>(m_pContainer->m_columns)[m_nIndex];
+    }
+
+    operator value_type() const {
+        return to_tuple(indices());
+    }
+
+    template<bool Enable = !IsConst, class = std::enable_if_t<Enable>>
+    const basic_row& operator=(const value_type& x) const {
+        assign(x, indices());
+        return *this;
+    }
+
+    // Copy the fields of another row, not the proxy itself
+    const basic_row& operator=(const basic_row& r) const {
+        static_assert(!IsConst, "Cannot assign through a const_row");
+        assign(static_cast<value_type>(r), indices());
+        return *this;
+    }
+
+    basic_row(const basic_row&) = default;
+
+    int index() const { return m_nIndex; }
+
+private:
+    template<std::size_t... I>
+    value_type to_tuple(std::index_sequence<I...>) const {
+        return value_type(get<I>()...);
+    }
+
+    template<std::size_t... I>
+    void assign(const value_type& x, std::index_sequence<I...>) const {
+        ((get<I>() = std::get<I>(x)), ...);
+    }
+
+    container_type *m_pContainer;   // The vector holding the row
+    int m_nIndex;                   // The index of the row
+};
+
+
+/*
+ * @brief Return a proxy for the row at the given index.
+ * @param index The index of the row to return.
+ */
+template<class... Fields>
+typename SoAVector<Fields...>::row SoAVector<Fields...>::operator[](int index) {
+    return row(this, index);
+}
+
+template<class... Fields>
+typename SoAVector<Fields...>::const_row SoAVector<Fields...>::operator[](int index) const {
+    return const_row(this, index);
+}
+
+/*
+ * @brief Return a proxy for the row at the given index. If the index is out of range, throw an exception.
+ * @param index The index of the row to return.
+ */
+template<class... Fields>
+typename SoAVector<Fields...>::row SoAVector<Fields...>::at(int index) {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return row(this, index);
+}
+
+template<class... Fields>
+typename SoAVector<Fields...>::const_row SoAVector<Fields...>::at(int index) const {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return const_row(this, index);
+}
+
+/*
+ * @brief Return a proxy for the last row. The vector must not be empty.
+ */
+template<class... Fields>
+typename SoAVector<Fields...>::row SoAVector<Fields...>::back() {
+    assert(size() > 0);
+    return row(this, size() - 1);
+}
+
+template<class... Fields>
+typename SoAVector<Fields...>::const_row SoAVector<Fields...>::back() const {
+    assert(size() > 0);
+    return const_row(this, size() - 1);
+}
+
+/*
+ * @brief Return the contiguous array of field I. It stays valid until the vector grows.
+ */
+template<class... Fields>
+template<std::size_t I>
+Span<typename SoAVector<Fields...>::template field_type<I>> SoAVector<Fields...>::column() {
+    auto& c = std::get<I>(m_columns);
+    return Span<field_type<I>>(c.data(), c.size());
+}
+
+template<class... Fields>
+template<std::size_t I>
+Span<const typename SoAVector<Fields...>::template field_type<I>> SoAVector<Fields...>::column() const {
+    const auto& c = std::get<I>(m_columns);
+    return Span<const field_type<I>>(c.data(), c.size());
+}
+
+/*
+ * @brief Return the number of rows in the vector.
+ */
+template<class... Fields>
+int SoAVector<Fields...>::size() const {
+    return std::get<0>(m_columns).size();
+}
+
+/*
+ * @brief Return the number of rows the columns can hold without growing. The columns have the
+ *        same capacity unless a reserve() failed halfway, so this is the smallest of them.
+ */
+template<class... Fields>
+int SoAVector<Fields...>::capacity() const {
+    return std::apply([](const auto&... columns) { return std::min({columns.capacity()...}); }, m_columns);
+}
+
+/*
+ * @brief Return true if the vector is empty.
+ */
+template<class... Fields>
+bool SoAVector<Fields...>::empty() const {
+    return size() == 0;
+}
+
+/*
+ * @brief Add a copy of the record to the end of the vector.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::push_back(const value_type& x) {
+    std::apply([this](const Fields&... fields) { emplace_back(fields...); }, x);
+}
+
+/*
+ * @brief Move the record to the end of the vector.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::push_back(value_type&& x) {
+    std::apply([this](Fields&... fields) { emplace_back(std::move(fields)...); }, x);
+}
+
+/*
+ * @brief Add a record whose field I is constructed from args[I].
+ *        If one field throws, the fields already added are removed again.
+ */
+template<class... Fields>
+template<class... Args>
+void SoAVector<Fields...>::emplace_back(Args&&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back() takes one argument per field");
+    if (size() == capacity()) {
+        grow_and_emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+    emplace_back_impl(indices(), std::forward<Args>(args)...);
+}
+
+/*
+ * @brief Remove the last record. The vector must not be empty.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::pop_back() {
+    assert(size() > 0);
+    pop_columns(indices(), sizeof...(Fields));
+}
+
+/*
+ * @brief Destroy every record. The columns keep their capacity.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::clear() {
+    std::apply([](auto&... columns) { (columns.clear(), ...); }, m_columns);
+}
+
+/*
+ * @brief Make room for new_capacity records in every column.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::reserve(int new_capacity) {
+    std::apply([new_capacity](auto&... columns) { (columns.reserve(new_capacity), ...); }, m_columns);
+}
+
+/*
+ * @brief Free the unused capacity of every column.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::shrink_to_fit() {
+    std::apply([](auto&... columns) { (columns.shrink_to_fit(), ...); }, m_columns);
+}
+
+/*
+ * @brief Exchange the contents of the two vectors.
+ */
+template<class... Fields>
+void SoAVector<Fields...>::swap(SoAVector<Fields...>& r) noexcept {
+    std::apply([&r](auto&... columns) {
+        std::apply([&columns...](auto&... r_columns) { (columns.swap(r_columns), ...); }, r.m_columns);
+    }, m_columns);
+}
+
+/*
+ * @brief Return the capacity the columns grow to when they are full, as a Vector would choose it.
+ */
+template<class... Fields>
+int SoAVector<Fields...>::next_capacity() const {
+    if (capacity() == INT_MAX) {
+        throw std::length_error("SoAVector is too long");
+    }
+    long long new_capacity = GrowDouble::next_capacity(capacity());
+    return new_capacity > INT_MAX ? INT_MAX : static_cast<int>(new_capacity);
+}
+
+/*
+ * @brief The slow path of emplace_back(): reserve every column to the same capacity, then add
+ *        the record. It is built first, since args may refer to fields of this vector.
+ */
+template<class... Fields>
+template<class... Args>
+void SoAVector<Fields...>::grow_and_emplace_back(Args&&... args) {
+    value_type record(std::forward<Args>(args)...);
+    reserve(next_capacity());
+    std::apply([this](Fields&... fields) { emplace_back_impl(indices(), std::move(fields)...); }, record);
+}
+
+template<class... Fields>
+template<class... Args, std::size_t... I>
+void SoAVector<Fields...>::emplace_back_impl(std::index_sequence<I...>, Args&&... args) {
+    std::size_t added = 0;
+    try {
+        ((std::get<I>(m_columns).emplace_back(std::forward<Args>(args)), added++), ...);
+    } catch (...) {
+        pop_columns(indices(), added);
+        throw;
+    }
+}
+
+/*
+ * @brief Remove the last element of the first count columns.
+ */
+template<class... Fields>
+template<std::size_t... I>
+void SoAVector<Fields...>::pop_columns(std::index_sequence<I...>, std::size_t count) {
+    ((I < count ? std::get<I>(m_columns).pop_back() : void()), ...);
+}
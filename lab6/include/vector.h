@@ -1,73 +1,363 @@
 #pragma once
 #include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 /*
- * Class template Vector
+ * Trait is_trivially_relocatable
+ * True if moving an object to a new address and forgetting the old one is the same as a memcpy.
+ * Every trivially copyable type qualifies; other types may opt in by specializing the trait.
  */
 template<class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<class U>
+struct is_trivially_relocatable<std::unique_ptr<U>> : std::true_type {};
+
+/*
+ * Optional allocator extensions used when the vector grows:
+ *   bool expand_in_place(T *p, size_t old_n, size_t new_n)  Grow the block at p without moving it.
+ *   T* reallocate(T *p, size_t old_n, size_t new_n)         Grow the block like realloc(), moving its bytes if needed.
+ * reallocate() is only used for trivially relocatable element types.
+ */
+template<class Alloc, class = void>
+struct alloc_has_expand_in_place : std::false_type {};
+
+template<class Alloc>
+struct alloc_has_expand_in_place<Alloc, std::void_t<decltype(std::declval<Alloc&>().expand_in_place(
+    std::declval<typename Alloc::value_type*>(), std::size_t(), std::size_t()))>> : std::true_type {};
+
+template<class Alloc, class = void>
+struct alloc_has_reallocate : std::false_type {};
+
+template<class Alloc>
+struct alloc_has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename Alloc::value_type*>(), std::size_t(), std::size_t()))>> : std::true_type {};
+
+/*
+ * Growth policies
+ * A policy maps the current capacity to the capacity of the next growth step.
+ *   GrowDouble      2x, the fewest reallocations (default)
+ *   GrowOneAndHalf  1.5x, less slack, lets freed blocks be reused by later growth steps
+ *   GrowChunk<K>    +K elements, bounded slack for huge vectors (best with an allocator supporting reallocate())
+ */
+struct GrowDouble {
+    static long long next_capacity(long long capacity) {
+        return capacity == 0 ? 1 : capacity * 2;
+    }
+};
+
+struct GrowOneAndHalf {
+    static long long next_capacity(long long capacity) {
+        return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+    }
+};
+
+template<int K>
+struct GrowChunk {
+    static_assert(K > 0, "GrowChunk needs a positive chunk size");
+
+    static long long next_capacity(long long capacity) {
+        return capacity + K;
+    }
+};
+
+template<class T, int N, class Alloc, class Growth> class SmallVector;
+
+/*
+ * Class template Vector
+ * The storage is obtained from Alloc as raw memory, so only the first m_nSize
+ * slots hold live objects. The spare capacity stays uninitialized until an
+ * element is constructed in place by push_back() or emplace_back().
+ * When the vector is full, Growth decides the next capacity.
+ * The elements are contiguous, so plain pointers serve as random-access iterators.
+ *
+ * A derived class may lend the vector an inline buffer placed right after the
+ * Vector subobject (see SmallVector). The buffer is used until it overflows and
+ * is never given to the allocator.
+ */
+template<class T, class Alloc = std::allocator<T>, class Growth = GrowDouble>
 class Vector {
 public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
     Vector();
     Vector(int size);
-    Vector(const Vector<T>& r);
+    Vector(const Vector<T, Alloc, Growth>& r);
+    Vector(const Vector<T, Alloc, Growth>& r, const Alloc& alloc);
+    Vector(Vector<T, Alloc, Growth>&& r) noexcept;
+    template<int N> Vector(SmallVector<T, N, Alloc, Growth>&& r);
     ~Vector();
 
+    Vector<T, Alloc, Growth>& operator=(const Vector<T, Alloc, Growth>& r);
+    Vector<T, Alloc, Growth>& operator=(Vector<T, Alloc, Growth>&& r) noexcept(
+        std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Alloc>::is_always_equal::value);
+    template<int N> Vector<T, Alloc, Growth>& operator=(SmallVector<T, N, Alloc, Growth>&& r);
+
     T& operator[](int index);
+    const T& operator[](int index) const;
     T& at(int index);
+    const T& at(int index) const;
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+    T* data();
+    const T* data() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
 
     int size() const;
+    int capacity() const;
     void push_back(const T& x);
+    void push_back(T&& x);
+    template<class... Args> T& emplace_back(Args&&... args);
+    void pop_back();
     void clear();
     bool empty() const;
 
+    void reserve(int new_capacity);
+    void resize(int new_size);
+    void resize(int new_size, const T& value);
+    void shrink_to_fit();
+
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator insert(const_iterator pos, int count, const T& value);
+    template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+    template<class... Args> iterator emplace(const_iterator pos, Args&&... args);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    void assign(int count, const T& value);
+    template<class InputIt, class = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> ilist);
+
+    void swap(Vector<T, Alloc, Growth>& r);
+    Alloc get_allocator() const;
+
+protected:
+    Vector(T *storage, int inline_capacity) noexcept;
+
+    bool is_inline() const;
+
 private:
+    typedef std::allocator_traits<Alloc> alloc_traits;
+
+    static constexpr bool trivially_relocatable = is_trivially_relocatable<T>::value;
+    static constexpr bool use_reallocate = trivially_relocatable && alloc_has_reallocate<Alloc>::value;
+    static constexpr bool can_shift = trivially_relocatable || std::is_nothrow_move_constructible<T>::value;
+
+    T* inline_buffer() const;
+    int next_capacity() const;
     void inflate();
+    void grow_to(int new_capacity);
+    bool expand_in_place(int new_capacity);
+    // Kept out of line so that the fast path of emplace_back() stays small enough to inline
+    template<class... Args> __attribute__((noinline)) T& inflate_and_emplace_back(Args&&... args);
+    template<class... Args> void resize_with(int new_size, const Args&... args);
+    template<class Make> iterator insert_with(int index, int count, Make make);
+    template<class Make> void assign_with(int count, Make make);
+    template<class Make> void construct_n(T *dst, int count, Make make);
+    void relocate_to(T *dst);
+    void relocate_range(T *first, int count, T *dst);
+    void shift(int from, int to, int count);
+    void reset_capacity(int min_capacity);
+    void adopt(T *new_pElements, int new_capacity);
+    void move_to_inline_buffer();
+    void copy_elements_from(const Vector<T, Alloc, Growth>& r);
+    void move_elements_from(Vector<T, Alloc, Growth>& r);
+    void steal(Vector<T, Alloc, Growth>& r);
+    void move_assign(Vector<T, Alloc, Growth>& r);
+    void destroy_range(T *first, T *last);
+    void destroy_all();
+    void release();
 
-    T *m_pElements;     // The pointer to the first element in the vector
-    int m_nSize;        // The number of elements in the vector
-    int m_nCapacity;    // The length of the allocated memory
+    Alloc m_allocator;          // The allocator which provides the raw storage
+    int m_nInlineCapacity;      // The capacity of the inline buffer lent by a derived class, 0 if none
+    T *m_pElements;             // The pointer to the first element in the vector
+    int m_nSize;                // The number of elements in the vector
+    int m_nCapacity;            // The length of the allocated memory
 };
 
 
 /*
  * @brief Default constructor. Creates an empty vector.
  */
-template<class T>
-Vector<T>::Vector(): m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {}
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(): m_allocator(), m_nInlineCapacity(0), m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {}
 
 /*
  * @brief Creates a new vector with the given size. The elements are default-constructed.
  * @param size The size of the vector.
  */
-template<class T>
-Vector<T>::Vector(int size): m_nSize(size), m_nCapacity(size) {
-    m_pElements = new T[size];
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(int size): m_allocator(), m_nInlineCapacity(0), m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {
+    if (size <= 0) {
+        return;
+    }
+    m_pElements = alloc_traits::allocate(m_allocator, size);
+    m_nCapacity = size;
+    try {
+        for (; m_nSize < size; m_nSize++) {
+            alloc_traits::construct(m_allocator, m_pElements + m_nSize);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
 }
 
 /*
  * @brief Copy constructor. Creates a new vector with the same elements as the given vector.
+ *        Only the live elements are copied, the new buffer is exactly as large as r.size().
  */
-template<class T>
-Vector<T>::Vector(const Vector<T>& r): m_nSize(r.m_nSize), m_nCapacity(r.m_nCapacity) {
-    m_pElements = new T[r.m_nCapacity];
-    std::copy(r.m_pElements, r.m_pElements + r.m_nSize, m_pElements);
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector<T, Alloc, Growth>& r)
+    : Vector(r, alloc_traits::select_on_container_copy_construction(r.m_allocator)) {}
+
+/*
+ * @brief Allocator-extended copy constructor. The copy gets its storage from alloc.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(const Vector<T, Alloc, Growth>& r, const Alloc& alloc)
+    : m_allocator(alloc), m_nInlineCapacity(0), m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {
+    if (r.m_nSize == 0) {
+        return;
+    }
+    m_pElements = alloc_traits::allocate(m_allocator, r.m_nSize);
+    m_nCapacity = r.m_nSize;
+    try {
+        copy_elements_from(r);
+    } catch (...) {
+        release();
+        throw;
+    }
 }
 
 /*
- * @brief Destructor. Deallocates the memory used by the vector.
+ * @brief Move constructor. Leaves r empty. A heap buffer of r is taken over as is, without
+ *        touching an element or allocating. Elements in an inline buffer cannot be taken over:
+ *        they are moved one by one into a newly allocated buffer. A SmallVector moved as itself
+ *        takes the overload below, which may throw; one moved through a Vector&& while its
+ *        elements are inline ends in std::terminate if that allocation or a move throws.
  */
-template<class T>
-Vector<T>::~Vector() {
-    delete[] m_pElements;
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(Vector<T, Alloc, Growth>&& r) noexcept
+    : m_allocator(std::move(r.m_allocator)), m_nInlineCapacity(0), m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {
+    steal(r);
+}
+
+/*
+ * @brief Move constructor from a SmallVector. A heap buffer is taken over as above, but inline
+ *        elements are moved (or copied, if T cannot be moved) into a new buffer, so this can throw.
+ */
+template<class T, class Alloc, class Growth>
+template<int N>
+Vector<T, Alloc, Growth>::Vector(SmallVector<T, N, Alloc, Growth>&& r)
+    : m_allocator(std::move(r.m_allocator)), m_nInlineCapacity(0), m_pElements(nullptr), m_nSize(0), m_nCapacity(0) {
+    try {
+        steal(r);
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+/*
+ * @brief Constructor for derived classes which own an inline buffer.
+ * @param storage The inline buffer, which must directly follow the Vector subobject.
+ * @param inline_capacity The number of elements the inline buffer can hold.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::Vector(T *storage, int inline_capacity) noexcept
+    : m_allocator(), m_nInlineCapacity(inline_capacity), m_pElements(storage), m_nSize(0), m_nCapacity(inline_capacity) {
+    assert(storage == inline_buffer());
+}
+
+/*
+ * @brief Destructor. Destroys the elements and returns the memory to the allocator.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>::~Vector() {
+    release();
+}
+
+/*
+ * @brief Copy assignment. The current buffer is reused if it is large enough, otherwise it is
+ *        replaced by one of exactly r.size() elements. The allocator of r is taken over only if
+ *        the allocator asks for it.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(const Vector<T, Alloc, Growth>& r) {
+    if (this == &r) {
+        return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+        if constexpr (!alloc_traits::is_always_equal::value) {
+            release();
+        }
+        m_allocator = r.m_allocator;
+    }
+
+    destroy_all();
+    reset_capacity(r.m_nSize);
+    copy_elements_from(r);
+    return *this;
+}
+
+/*
+ * @brief Move assignment. Leaves r empty. A heap buffer of r is taken over as is when the two
+ *        allocators can free each other's memory. Otherwise, and whenever r holds its elements in
+ *        an inline buffer, the elements are moved one by one into our own storage, which may
+ *        have to grow.
+ */
+template<class T, class Alloc, class Growth>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(Vector<T, Alloc, Growth>&& r) noexcept(
+    std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Alloc>::is_always_equal::value) {
+    move_assign(r);
+    return *this;
+}
+
+/*
+ * @brief Move assignment from a SmallVector. The same as above, but it can throw when the
+ *        elements of r are inline, since they are moved into our storage one by one.
+ */
+template<class T, class Alloc, class Growth>
+template<int N>
+Vector<T, Alloc, Growth>& Vector<T, Alloc, Growth>::operator=(SmallVector<T, N, Alloc, Growth>&& r) {
+    move_assign(r);
+    return *this;
 }
 
 /*
  * @brief Return the element at the given index.
  * @param index The index of the element to return.
  */
-template<class T>
-T& Vector<T>::operator[](int index) {
+template<class T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::operator[](int index) {
     return m_pElements[index];
 }
 
@@ -75,66 +365,899 @@ T& Vector<T>::operator[](int index) {
  * @brief Return the element at the given index. If the index is out of range, throw an exception.
  * @param index The index of the element to return.
  */
-template<class T>
-T& Vector<T>::at(int index) {
+template<class T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::at(int index) {
+    if (index < 0 || index >= m_nSize) {
+        throw std::out_of_range("Index out of range");
+    }
+    return m_pElements[index];
+}
+
+/*
+ * @brief Return the element at the given index (read-only).
+ * @param index The index of the element to return.
+ */
+template<class T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::operator[](int index) const {
+    return m_pElements[index];
+}
+
+/*
+ * @brief Return the element at the given index (read-only). If the index is out of range, throw an exception.
+ * @param index The index of the element to return.
+ */
+template<class T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::at(int index) const {
     if (index < 0 || index >= m_nSize) {
         throw std::out_of_range("Index out of range");
     }
     return m_pElements[index];
 }
 
+/*
+ * @brief Return the first element. The vector must not be empty.
+ */
+template<class T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::front() {
+    assert(m_nSize > 0);
+    return m_pElements[0];
+}
+
+template<class T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::front() const {
+    assert(m_nSize > 0);
+    return m_pElements[0];
+}
+
+/*
+ * @brief Return the last element. The vector must not be empty.
+ */
+template<class T, class Alloc, class Growth>
+T& Vector<T, Alloc, Growth>::back() {
+    assert(m_nSize > 0);
+    return m_pElements[m_nSize - 1];
+}
+
+template<class T, class Alloc, class Growth>
+const T& Vector<T, Alloc, Growth>::back() const {
+    assert(m_nSize > 0);
+    return m_pElements[m_nSize - 1];
+}
+
+/*
+ * @brief Return the pointer to the first element (nullptr if nothing was ever allocated).
+ */
+template<class T, class Alloc, class Growth>
+T* Vector<T, Alloc, Growth>::data() {
+    return m_pElements;
+}
+
+template<class T, class Alloc, class Growth>
+const T* Vector<T, Alloc, Growth>::data() const {
+    return m_pElements;
+}
+
+/*
+ * @brief Return an iterator to the first element.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::begin() {
+    return m_pElements;
+}
+
+/*
+ * @brief Return an iterator past the last element.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::end() {
+    return m_pElements + m_nSize;
+}
+
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::begin() const {
+    return m_pElements;
+}
+
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::end() const {
+    return m_pElements + m_nSize;
+}
+
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cbegin() const {
+    return m_pElements;
+}
+
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Vector<T, Alloc, Growth>::cend() const {
+    return m_pElements + m_nSize;
+}
+
 /*
  * @brief Return the number of elements in the vector.
  */
-template<class T>
-int Vector<T>::size() const {
+template<class T, class Alloc, class Growth>
+int Vector<T, Alloc, Growth>::size() const {
     return m_nSize;
 }
 
 /*
- * @brief Append a new element to the end of the vector.
+ * @brief Return the number of elements the allocated memory can hold.
+ */
+template<class T, class Alloc, class Growth>
+int Vector<T, Alloc, Growth>::capacity() const {
+    return m_nCapacity;
+}
+
+/*
+ * @brief Append a copy of value to the end of the vector.
  * @param value The value of the new element.
  */
-template<class T>
-void Vector<T>::push_back(const T& value) {
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+/*
+ * @brief Append value to the end of the vector by moving it.
+ * @param value The value of the new element.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+/*
+ * @brief Construct a new element at the end of the vector from args.
+ * @param args The arguments forwarded to the constructor of T.
+ * @return A reference to the new element.
+ */
+template<class T, class Alloc, class Growth>
+template<class... Args>
+T& Vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
     if (m_nSize == m_nCapacity) {
-        inflate();
+        return inflate_and_emplace_back(std::forward<Args>(args)...);
     }
-    m_pElements[m_nSize++] = value;
+    alloc_traits::construct(m_allocator, m_pElements + m_nSize, std::forward<Args>(args)...);
+    return m_pElements[m_nSize++];
 }
 
 /*
- * @brief Clear the vector and deallocate the memory.
+ * @brief Remove the last element. The vector must not be empty.
  */
-template<class T>
-void Vector<T>::clear() {
-    delete[] m_pElements;
-    m_pElements = nullptr;
-    m_nSize = 0;
-    m_nCapacity = 0;
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::pop_back() {
+    assert(m_nSize > 0);
+    alloc_traits::destroy(m_allocator, m_pElements + m_nSize - 1);
+    m_nSize--;
+}
+
+/*
+ * @brief Destroy all the elements. The capacity is kept, so refilling the vector does not allocate;
+ *        call shrink_to_fit() afterwards to give the memory back.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::clear() {
+    destroy_all();
 }
 
 /*
  * @brief Return true if the vector is empty, false otherwise.
  */
-template<class T>
-bool Vector<T>::empty() const {
+template<class T, class Alloc, class Growth>
+bool Vector<T, Alloc, Growth>::empty() const {
     return m_nSize == 0;
 }
 
 /*
- * @brief Inflates the capacity of the vector by doubling it.
+ * @brief Make sure the vector can hold new_capacity elements without reallocating.
  */
-template<class T>
-void Vector<T>::inflate() {
-    if (m_nCapacity == 0) {
-        m_nCapacity = 1;
-        m_pElements = new T[m_nCapacity];
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::reserve(int new_capacity) {
+    if (new_capacity > m_nCapacity) {
+        grow_to(new_capacity);
+    }
+}
+
+/*
+ * @brief Change the size of the vector. New elements are value-initialized.
+ * @param new_size The new size of the vector.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::resize(int new_size) {
+    resize_with(new_size);
+}
+
+/*
+ * @brief Change the size of the vector. New elements are copies of value.
+ * @param new_size The new size of the vector.
+ * @param value The value of the new elements.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::resize(int new_size, const T& value) {
+    if (new_size > m_nCapacity && &value >= m_pElements && &value < m_pElements + m_nSize) {
+        T copy(value);  // value lives in the buffer that is about to be reallocated
+        resize_with(new_size, copy);
+    } else {
+        resize_with(new_size, value);
+    }
+}
+
+/*
+ * @brief Reduce the capacity to the size of the vector.
+ *        A vector with an inline buffer moves back into it when the elements fit.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::shrink_to_fit() {
+    if (m_nCapacity == m_nSize || is_inline()) {
+        return;
+    }
+    if (m_nInlineCapacity > 0 && m_nSize <= m_nInlineCapacity) {
+        move_to_inline_buffer();
+        return;
+    }
+    if (m_nSize == 0) {
+        release();
+        return;
+    }
+    if constexpr (use_reallocate) {
+        m_pElements = m_allocator.reallocate(m_pElements, m_nCapacity, m_nSize);
+        m_nCapacity = m_nSize;
+        return;
+    }
+
+    T *new_pElements = alloc_traits::allocate(m_allocator, m_nSize);
+    try {
+        relocate_to(new_pElements);
+    } catch (...) {
+        alloc_traits::deallocate(m_allocator, new_pElements, m_nSize);
+        throw;
+    }
+    adopt(new_pElements, m_nSize);
+}
+
+/*
+ * @brief Insert a copy of value before pos.
+ * @return An iterator to the inserted element.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+}
+
+/*
+ * @brief Insert value before pos by moving it.
+ * @return An iterator to the inserted element.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+}
+
+/*
+ * @brief Insert count copies of value before pos.
+ * @return An iterator to the first inserted element (pos if count is 0).
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, int count, const T& value) {
+    int index = static_cast<int>(pos - m_pElements);
+    if (&value >= m_pElements && &value < m_pElements + m_nSize) {
+        T copy(value);  // value lives in the range that is about to move
+        return insert_with(index, count, [&](T *p) { alloc_traits::construct(m_allocator, p, copy); });
+    }
+    return insert_with(index, count, [&](T *p) { alloc_traits::construct(m_allocator, p, value); });
+}
+
+/*
+ * @brief Insert the elements of [first, last) before pos. The range must not point into this vector.
+ *        For forward iterators the tail is relocated once; single-pass input iterators are appended
+ *        and rotated into place.
+ * @return An iterator to the first inserted element (pos if the range is empty).
+ */
+template<class T, class Alloc, class Growth>
+template<class InputIt, class>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, InputIt first, InputIt last) {
+    int index = static_cast<int>(pos - m_pElements);
+    typedef typename std::iterator_traits<InputIt>::iterator_category category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        int count = static_cast<int>(std::distance(first, last));
+        return insert_with(index, count, [&](T *p) { alloc_traits::construct(m_allocator, p, *first); ++first; });
+    } else {
+        int old_size = m_nSize;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(m_pElements + index, m_pElements + old_size, m_pElements + m_nSize);
+        return m_pElements + index;
+    }
+}
+
+/*
+ * @brief Insert the elements of ilist before pos.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
+}
+
+/*
+ * @brief Construct a new element from args before pos.
+ * @return An iterator to the new element.
+ */
+template<class T, class Alloc, class Growth>
+template<class... Args>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::emplace(const_iterator pos, Args&&... args) {
+    int index = static_cast<int>(pos - m_pElements);
+    if (index == m_nSize) {
+        emplace_back(std::forward<Args>(args)...);
+        return m_pElements + index;
+    }
+    T value(std::forward<Args>(args)...);  // args may refer to an element which is about to move
+    return insert_with(index, 1, [&](T *p) { alloc_traits::construct(m_allocator, p, std::move(value)); });
+}
+
+/*
+ * @brief Remove the element at pos.
+ * @return An iterator to the element following the removed one.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+}
+
+/*
+ * @brief Remove the elements in [first, last). The tail is relocated once to close the gap.
+ * @return An iterator to the element following the removed ones.
+ */
+template<class T, class Alloc, class Growth>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
+    int index = static_cast<int>(first - m_pElements);
+    int count = static_cast<int>(last - first);
+    if (count <= 0) {
+        return m_pElements + index;
+    }
+
+    if constexpr (can_shift) {
+        destroy_range(m_pElements + index, m_pElements + index + count);
+        shift(index + count, index, m_nSize - index - count);
+    } else {
+        std::move(m_pElements + index + count, m_pElements + m_nSize, m_pElements + index);
+        destroy_range(m_pElements + m_nSize - count, m_pElements + m_nSize);
+    }
+    m_nSize -= count;
+    return m_pElements + index;
+}
+
+/*
+ * @brief Replace the contents with count copies of value.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::assign(int count, const T& value) {
+    if (&value >= m_pElements && &value < m_pElements + m_nSize) {
+        T copy(value);  // value lives in the range that is about to be destroyed
+        assign_with(count, [&](T *p) { alloc_traits::construct(m_allocator, p, copy); });
     } else {
-        m_nCapacity *= 2;
-        T *new_pElements = new T[m_nCapacity];
-        std::copy(m_pElements, m_pElements + m_nSize, new_pElements);
-        delete[] m_pElements;
-        m_pElements = new_pElements;
+        assign_with(count, [&](T *p) { alloc_traits::construct(m_allocator, p, value); });
+    }
+}
+
+/*
+ * @brief Replace the contents with the elements of [first, last). The range must not point into this vector.
+ */
+template<class T, class Alloc, class Growth>
+template<class InputIt, class>
+void Vector<T, Alloc, Growth>::assign(InputIt first, InputIt last) {
+    typedef typename std::iterator_traits<InputIt>::iterator_category category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+        int count = static_cast<int>(std::distance(first, last));
+        assign_with(count, [&](T *p) { alloc_traits::construct(m_allocator, p, *first); ++first; });
+    } else {
+        destroy_all();
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+/*
+ * @brief Replace the contents with the elements of ilist.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::assign(std::initializer_list<T> ilist) {
+    assign(ilist.begin(), ilist.end());
+}
+
+/*
+ * @brief Exchange the contents of the two vectors.
+ *        Heap buffers are swapped without touching any element and without throwing. Elements in
+ *        an inline buffer have to be moved, which may allocate, so then swap() can throw. The
+ *        moves go through move_assign(), not the noexcept move operations, so that the exception
+ *        reaches the caller; both vectors stay valid, but some elements may have been lost.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::swap(Vector<T, Alloc, Growth>& r) {
+    if (this == &r) {
+        return;
+    }
+    if (is_inline() || r.is_inline()) {
+        Vector<T, Alloc, Growth> tmp;
+        tmp.move_assign(*this);
+        move_assign(r);
+        r.move_assign(tmp);
+        return;
+    }
+    if (alloc_traits::propagate_on_container_swap::value) {
+        std::swap(m_allocator, r.m_allocator);
+    }
+    std::swap(m_pElements, r.m_pElements);
+    std::swap(m_nSize, r.m_nSize);
+    std::swap(m_nCapacity, r.m_nCapacity);
+}
+
+/*
+ * @brief Return a copy of the allocator used by the vector.
+ */
+template<class T, class Alloc, class Growth>
+Alloc Vector<T, Alloc, Growth>::get_allocator() const {
+    return m_allocator;
+}
+
+/*
+ * @brief Return true if the elements are stored in the inline buffer of a derived class.
+ */
+template<class T, class Alloc, class Growth>
+bool Vector<T, Alloc, Growth>::is_inline() const {
+    return m_nInlineCapacity > 0 && m_pElements == inline_buffer();
+}
+
+/*
+ * @brief Return the address of the inline buffer: the first suitably aligned byte after the Vector subobject.
+ */
+template<class T, class Alloc, class Growth>
+T* Vector<T, Alloc, Growth>::inline_buffer() const {
+    constexpr std::size_t offset = (sizeof(Vector<T, Alloc, Growth>) + alignof(T) - 1) / alignof(T) * alignof(T);
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(const_cast<Vector<T, Alloc, Growth>*>(this)) + offset);
+}
+
+/*
+ * @brief Return the capacity used by the next growth step, as decided by the growth policy.
+ *        The result is capped at INT_MAX; a full vector of INT_MAX elements cannot grow any more.
+ */
+template<class T, class Alloc, class Growth>
+int Vector<T, Alloc, Growth>::next_capacity() const {
+    if (m_nCapacity == INT_MAX) {
+        throw std::length_error("Vector is too long");
+    }
+    long long new_capacity = Growth::next_capacity(m_nCapacity);
+    return new_capacity > INT_MAX ? INT_MAX : static_cast<int>(new_capacity);
+}
+
+/*
+ * @brief Inflates the capacity of the vector by one step of the growth policy.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::inflate() {
+    grow_to(next_capacity());
+}
+
+/*
+ * @brief Grow the buffer to new_capacity.
+ *        The allocator is first asked to expand the block in place. Trivially relocatable elements
+ *        are then handed to the allocator's reallocate() if it has one, and otherwise relocated into
+ *        a fresh buffer. If relocating an element throws, the old buffer is kept untouched.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::grow_to(int new_capacity) {
+    if (expand_in_place(new_capacity)) {
+        return;
+    }
+    if constexpr (use_reallocate) {
+        if (!is_inline()) {
+            m_pElements = m_allocator.reallocate(m_pElements, m_nCapacity, new_capacity);
+            m_nCapacity = new_capacity;
+            return;
+        }
+    }
+
+    T *new_pElements = alloc_traits::allocate(m_allocator, new_capacity);
+    try {
+        relocate_to(new_pElements);
+    } catch (...) {
+        alloc_traits::deallocate(m_allocator, new_pElements, new_capacity);
+        throw;
+    }
+    adopt(new_pElements, new_capacity);
+}
+
+/*
+ * @brief Try to grow the current block to new_capacity without moving it.
+ * @return true if the allocator supports it and succeeded.
+ */
+template<class T, class Alloc, class Growth>
+bool Vector<T, Alloc, Growth>::expand_in_place(int new_capacity) {
+    if constexpr (alloc_has_expand_in_place<Alloc>::value) {
+        if (m_pElements != nullptr && !is_inline() && m_allocator.expand_in_place(m_pElements, m_nCapacity, new_capacity)) {
+            m_nCapacity = new_capacity;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief Slow path of emplace_back(): inflate the buffer and construct the new element in it.
+ *        The new element is built before the old ones are relocated (or, with reallocate(), into
+ *        a temporary), so args may safely refer to an element of this vector.
+ */
+template<class T, class Alloc, class Growth>
+template<class... Args>
+T& Vector<T, Alloc, Growth>::inflate_and_emplace_back(Args&&... args) {
+    int new_capacity = next_capacity();
+    if (expand_in_place(new_capacity)) {
+        alloc_traits::construct(m_allocator, m_pElements + m_nSize, std::forward<Args>(args)...);
+        return m_pElements[m_nSize++];
+    }
+
+    if constexpr (use_reallocate) {
+        if (!is_inline()) {
+            T value(std::forward<Args>(args)...);
+            grow_to(new_capacity);
+            alloc_traits::construct(m_allocator, m_pElements + m_nSize, std::move(value));
+            return m_pElements[m_nSize++];
+        }
+    }
+
+    T *new_pElements = alloc_traits::allocate(m_allocator, new_capacity);
+    try {
+        alloc_traits::construct(m_allocator, new_pElements + m_nSize, std::forward<Args>(args)...);
+    } catch (...) {
+        alloc_traits::deallocate(m_allocator, new_pElements, new_capacity);
+        throw;
+    }
+    try {
+        relocate_to(new_pElements);
+    } catch (...) {
+        alloc_traits::destroy(m_allocator, new_pElements + m_nSize);
+        alloc_traits::deallocate(m_allocator, new_pElements, new_capacity);
+        throw;
+    }
+
+    adopt(new_pElements, new_capacity);
+    return m_pElements[m_nSize++];
+}
+
+/*
+ * @brief Shared implementation of resize(): destroy the tail, or append elements built from args.
+ *        Growing beyond the next growth step reserves exactly new_size, otherwise one step is taken.
+ */
+template<class T, class Alloc, class Growth>
+template<class... Args>
+void Vector<T, Alloc, Growth>::resize_with(int new_size, const Args&... args) {
+    if (new_size <= m_nSize) {
+        destroy_range(m_pElements + std::max(new_size, 0), m_pElements + m_nSize);
+        m_nSize = std::max(new_size, 0);
+        return;
+    }
+    if (new_size > m_nCapacity) {
+        grow_to(std::max(new_size, next_capacity()));
+    }
+    for (; m_nSize < new_size; m_nSize++) {
+        alloc_traits::construct(m_allocator, m_pElements + m_nSize, args...);
+    }
+}
+
+/*
+ * @brief Shared implementation of insert(): make room for count elements at index and build them
+ *        with make(p), which constructs one element at the raw slot p.
+ *        If the buffer is large enough, the tail is relocated once to open a gap (element types whose
+ *        move may throw always take the reallocating path, which keeps the strong guarantee).
+ *        Otherwise the new elements are built in a new buffer first and the old elements are
+ *        relocated around them, each exactly once.
+ */
+template<class T, class Alloc, class Growth>
+template<class Make>
+typename Vector<T, Alloc, Growth>::iterator Vector<T, Alloc, Growth>::insert_with(int index, int count, Make make) {
+    if (count <= 0) {
+        return m_pElements + index;
+    }
+    if (static_cast<long long>(m_nSize) + count > INT_MAX) {
+        throw std::length_error("Vector is too long");
+    }
+
+    if (can_shift && m_nSize + count <= m_nCapacity) {
+        int tail = m_nSize - index;
+        shift(index, index + count, tail);
+        try {
+            construct_n(m_pElements + index, count, make);
+        } catch (...) {
+            shift(index + count, index, tail);
+            throw;
+        }
+        m_nSize += count;
+        return m_pElements + index;
+    }
+
+    int new_capacity = m_nSize + count;
+    if (m_nCapacity < INT_MAX) {
+        new_capacity = std::max(new_capacity, next_capacity());
+    }
+    T *new_pElements = alloc_traits::allocate(m_allocator, new_capacity);
+    try {
+        construct_n(new_pElements + index, count, make);
+    } catch (...) {
+        alloc_traits::deallocate(m_allocator, new_pElements, new_capacity);
+        throw;
+    }
+    try {
+        relocate_range(m_pElements, index, new_pElements);
+        try {
+            relocate_range(m_pElements + index, m_nSize - index, new_pElements + index + count);
+        } catch (...) {
+            destroy_range(new_pElements, new_pElements + index);
+            throw;
+        }
+    } catch (...) {
+        destroy_range(new_pElements + index, new_pElements + index + count);
+        alloc_traits::deallocate(m_allocator, new_pElements, new_capacity);
+        throw;
+    }
+
+    adopt(new_pElements, new_capacity);
+    m_nSize += count;
+    return m_pElements + index;
+}
+
+/*
+ * @brief Shared implementation of assign(): replace the contents with count elements built by make(p).
+ */
+template<class T, class Alloc, class Growth>
+template<class Make>
+void Vector<T, Alloc, Growth>::assign_with(int count, Make make) {
+    destroy_all();
+    if (count <= 0) {
+        return;
+    }
+    reset_capacity(count);
+    construct_n(m_pElements, count, make);
+    m_nSize = count;
+}
+
+/*
+ * @brief Call make(p) on the raw slots dst, ..., dst + count - 1.
+ *        If one construction throws, the elements already built are destroyed.
+ */
+template<class T, class Alloc, class Growth>
+template<class Make>
+void Vector<T, Alloc, Growth>::construct_n(T *dst, int count, Make make) {
+    int constructed = 0;
+    try {
+        for (; constructed < count; constructed++) {
+            make(dst + constructed);
+        }
+    } catch (...) {
+        destroy_range(dst, dst + constructed);
+        throw;
+    }
+}
+
+/*
+ * @brief Move (or copy) the live elements into the raw buffer dst.
+ *        Trivially relocatable elements are moved with a single memcpy.
+ *        Other elements are moved only if T's move constructor is noexcept or T cannot be copied,
+ *        so a throwing copy leaves the source intact (strong exception guarantee).
+ *        On exception, the elements already built in dst are destroyed.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::relocate_to(T *dst) {
+    relocate_range(m_pElements, m_nSize, dst);
+}
+
+/*
+ * @brief Move (or copy) the count elements starting at first into the raw buffer dst, with the
+ *        same rules and guarantees as relocate_to().
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::relocate_range(T *first, int count, T *dst) {
+    if constexpr (trivially_relocatable) {
+        if (count > 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(first), count * sizeof(T));
+        }
+        return;
+    }
+    int constructed = 0;
+    try {
+        for (; constructed < count; constructed++) {
+            alloc_traits::construct(m_allocator, dst + constructed, std::move_if_noexcept(first[constructed]));
+        }
+    } catch (...) {
+        destroy_range(dst, dst + constructed);
+        throw;
+    }
+}
+
+/*
+ * @brief Relocate the count elements at index from to index to, inside the buffer. The slots of
+ *        the destination not covered by the source must be raw; afterwards, the slots of the source
+ *        not covered by the destination are raw. Used only when relocation cannot throw
+ *        (memmove for trivially relocatable types, move-construct + destroy otherwise).
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::shift(int from, int to, int count) {
+    if (count <= 0 || from == to) {
+        return;
+    }
+    if constexpr (trivially_relocatable) {
+        std::memmove(static_cast<void*>(m_pElements + to), static_cast<const void*>(m_pElements + from), count * sizeof(T));
+    } else if (to > from) {
+        for (int i = count - 1; i >= 0; i--) {
+            alloc_traits::construct(m_allocator, m_pElements + to + i, std::move(m_pElements[from + i]));
+            alloc_traits::destroy(m_allocator, m_pElements + from + i);
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            alloc_traits::construct(m_allocator, m_pElements + to + i, std::move(m_pElements[from + i]));
+            alloc_traits::destroy(m_allocator, m_pElements + from + i);
+        }
+    }
+}
+
+/*
+ * @brief Make sure the (empty) vector has room for min_capacity elements, replacing the buffer by one
+ *        of exactly min_capacity elements if it is too small. Unlike reserve(), nothing is relocated.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::reset_capacity(int min_capacity) {
+    if (min_capacity > m_nCapacity) {
+        release();
+        m_pElements = alloc_traits::allocate(m_allocator, min_capacity);
+        m_nCapacity = min_capacity;
+    }
+}
+
+/*
+ * @brief Switch to new_pElements after relocate_to() filled it, and free the old buffer.
+ *        Trivially relocated elements now live in the new buffer only, so the old copies are not destroyed.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::adopt(T *new_pElements, int new_capacity) {
+    if constexpr (!trivially_relocatable) {
+        destroy_range(m_pElements, m_pElements + m_nSize);
+    }
+    if (m_pElements != nullptr && !is_inline()) {
+        alloc_traits::deallocate(m_allocator, m_pElements, m_nCapacity);
+    }
+    m_pElements = new_pElements;
+    m_nCapacity = new_capacity;
+}
+
+/*
+ * @brief Relocate the elements from the heap back into the inline buffer, which must be large enough.
+ *        Kept out of line: once inlined into code using a plain Vector, GCC sees a copy past the end
+ *        of the object on this (unreachable) path and reports -Warray-bounds.
+ */
+template<class T, class Alloc, class Growth>
+__attribute__((noinline)) void Vector<T, Alloc, Growth>::move_to_inline_buffer() {
+    relocate_to(inline_buffer());
+    adopt(inline_buffer(), m_nInlineCapacity);
+}
+
+/*
+ * @brief Copy-construct the elements of r into our empty buffer, which must hold at least r.size() elements.
+ *        m_nSize is kept up to date, so the copies are destroyed properly if one of them throws.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::copy_elements_from(const Vector<T, Alloc, Growth>& r) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (r.m_nSize > 0) {
+            std::memcpy(m_pElements, r.m_pElements, r.m_nSize * sizeof(T));
+        }
+        m_nSize = r.m_nSize;
+        return;
+    }
+    for (; m_nSize < r.m_nSize; m_nSize++) {
+        alloc_traits::construct(m_allocator, m_pElements + m_nSize, r.m_pElements[m_nSize]);
+    }
+}
+
+/*
+ * @brief Move the elements of r to the end of our empty vector and leave r empty (keeping its buffer).
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::move_elements_from(Vector<T, Alloc, Growth>& r) {
+    if (r.m_nSize > m_nCapacity) {
+        grow_to(r.m_nSize);
+    }
+    if constexpr (trivially_relocatable) {
+        if (r.m_nSize > 0) {
+            std::memcpy(static_cast<void*>(m_pElements), static_cast<const void*>(r.m_pElements), r.m_nSize * sizeof(T));
+        }
+        m_nSize = r.m_nSize;
+        r.m_nSize = 0;
+        return;
+    }
+    for (; m_nSize < r.m_nSize; m_nSize++) {
+        alloc_traits::construct(m_allocator, m_pElements + m_nSize, std::move(r.m_pElements[m_nSize]));
+    }
+    r.destroy_all();
+}
+
+/*
+ * @brief Take over the contents of r, leaving r empty. The heap buffer of r (and, if it propagates,
+ *        the allocator) is taken as is; elements held in r's inline buffer are moved instead, which
+ *        may allocate and throw.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::steal(Vector<T, Alloc, Growth>& r) {
+    if (r.is_inline()) {
+        destroy_all();
+        move_elements_from(r);
+        return;
+    }
+
+    release();
+    if (alloc_traits::propagate_on_container_move_assignment::value) {
+        m_allocator = std::move(r.m_allocator);
+    }
+    m_pElements = r.m_pElements;
+    m_nSize = r.m_nSize;
+    m_nCapacity = r.m_nCapacity;
+    r.m_pElements = r.m_nInlineCapacity > 0 ? r.inline_buffer() : nullptr;
+    r.m_nSize = 0;
+    r.m_nCapacity = r.m_nInlineCapacity;
+}
+
+/*
+ * @brief The body of both move assignments: steal the buffer of r when the allocators allow it,
+ *        otherwise move the elements one by one.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::move_assign(Vector<T, Alloc, Growth>& r) {
+    if (this == &r) {
+        return;
+    }
+
+    constexpr bool can_steal = alloc_traits::propagate_on_container_move_assignment::value ||
+                               alloc_traits::is_always_equal::value;
+    if constexpr (can_steal) {
+        steal(r);
+    } else if (m_allocator == r.m_allocator) {
+        steal(r);
+    } else {
+        destroy_all();
+        move_elements_from(r);
+        r.release();
+    }
+}
+
+/*
+ * @brief Destroy the elements in [first, last).
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::destroy_range(T *first, T *last) {
+    for (; first != last; ++first) {
+        alloc_traits::destroy(m_allocator, first);
+    }
+}
+
+/*
+ * @brief Destroy all the elements but keep the buffer.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::destroy_all() {
+    destroy_range(m_pElements, m_pElements + m_nSize);
+    m_nSize = 0;
+}
+
+/*
+ * @brief Destroy all the elements and give the buffer back to the allocator.
+ *        A vector with an inline buffer falls back to it.
+ */
+template<class T, class Alloc, class Growth>
+void Vector<T, Alloc, Growth>::release() {
+    destroy_all();
+    if (m_pElements != nullptr && !is_inline()) {
+        alloc_traits::deallocate(m_allocator, m_pElements, m_nCapacity);
     }
+    m_pElements = m_nInlineCapacity > 0 ? inline_buffer() : nullptr;
+    m_nCapacity = m_nInlineCapacity;
 }
@@ -2,13 +2,32 @@
 // We will conduct difftest between our Vector<T> and std::vector<T>.
 
 #include "vector.h"
-#include <_stdlib.h>
+#include "chunked_vector.h"
+#include "concurrent_vector.h"
+#include "numeric_vector.h"
+#include "soa_vector.h"
+#include "mapped_vector.h"
+#include "cow_vector.h"
+#include "realloc_allocator.h"
+#include "small_vector.h"
+#include "test_class.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <random>
+#include <thread>
 #include <vector>
 #include <assert.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 
 // Define color macros for console output
 #define COLOR_GREEN "\033[32m"
@@ -27,64 +46,61 @@
 // Random generator class to generate random integers, doubles, and strings
 class RandomGenerator {
 public:
+    // The generator shared by every call, seeded once
+    static std::mt19937& Engine() {
+        static std::mt19937 gen(std::random_device{}());
+        return gen;
+    }
+
     // Generate a random integer between low and high (inclusive)
     static int RandomInt(int low, int high) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_int_distribution<int64_t> dist(low, high);
-        return dist(gen);
+        return dist(Engine());
     }
 
     // Generate a random double between low and high (inclusive)
     static double RandomDouble(double low, double high) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<double> dist(low, high);
-        return dist(gen);
+        return dist(Engine());
     }
 
     // Generate a random string of length length
     static std::string RandomString(int length) {
-        char *buf = new char[length];
+        std::string buf(length, ' ');
         for (int i = 0; i < length; i++) {
             buf[i] = RandomInt(33, 122);
         }
-        return std::string(buf, length);
+        return buf;
     }
 };
 
-// The class is used to test Vector<TestClass>
-class TestClass {
-private:
-    int int_field;
-    double double_field;
-    std::string string_field;
+// The class counts its live instances, used to check that Vector<T> never constructs spare slots
+class LiveCounter {
 public:
-    TestClass(int int_field = 0, double double_field = 0.0, std::string string_field = "") : int_field(int_field), double_field(double_field), string_field(string_field) {}
-    
-    TestClass(const TestClass& other) : int_field(other.int_field), double_field(other.double_field), string_field(other.string_field) {}
+    static int live;
 
-    bool operator==(const TestClass& other) const {
-        return int_field == other.int_field && double_field == other.double_field && string_field == other.string_field;
-    }
+    LiveCounter() { live++; }
+    LiveCounter(const LiveCounter&) { live++; }
+    ~LiveCounter() { live--; }
+};
 
-    TestClass& operator=(const TestClass& other) {
-        if (this != &other) {
-            int_field = other.int_field;
-            double_field = other.double_field;
-            string_field = other.string_field;
-        }
-        return *this;
-    }
+int LiveCounter::live = 0;
 
-    // Randomize the fields of the object
-    void Randomize() {
-        int_field = RandomGenerator::RandomInt(0, 1000000);
-        double_field = RandomGenerator::RandomDouble(0.0, 1000000.0);
-        string_field = RandomGenerator::RandomString(128);
+// The class can only be copied, and its copy constructor throws once copies_left reaches zero
+class ThrowingCopy {
+public:
+    static int copies_left;
+
+    ThrowingCopy() {}
+    ThrowingCopy(const ThrowingCopy&) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
     }
 };
 
+int ThrowingCopy::copies_left = INT_MAX;
+
 int main() {
     int N = 10000;
 
@@ -217,7 +233,7 @@ int main() {
     // Test Vector<TestClass>::push_back()
     for (int i = 0; i < N; i++) {
         TestClass tc;
-        tc.Randomize();
+        tc = TestClass::Random(RandomGenerator::Engine());
         v4.push_back(tc);
         std_v4.push_back(tc);
     }
@@ -242,6 +258,804 @@ int main() {
 
     std::cout << SUCCESS_MSG("Vector<TestClass> passed all tests") << std::endl;
 
+    // Test the uninitialized storage of Vector<T>
+    std::cout << INFO_MSG("4. Testing Vector<LiveCounter>...") << std::endl;
+
+    {
+        Vector<LiveCounter> v5;
+        LiveCounter lc;
+        for (int i = 0; i < N; i++) {
+            v5.push_back(lc);
+            // Only the pushed elements (and lc itself) may be alive, whatever the capacity is
+            ASSERT(LiveCounter::live == v5.size() + 1, ERROR_MSG("Spare capacity was constructed"));
+        }
+        ASSERT(v5.capacity() >= v5.size(), ERROR_MSG("Capacity smaller than size"));
+
+        Vector<LiveCounter> v6(v5);
+        ASSERT(LiveCounter::live == 2 * N + 1, ERROR_MSG("Copy constructor constructed wrong number of elements"));
+
+        v5.clear();
+        ASSERT(LiveCounter::live == N + 1, ERROR_MSG("clear() did not destroy the elements"));
+    }
+    ASSERT(LiveCounter::live == 0, ERROR_MSG("Destructor did not destroy the elements"));
+
+    std::cout << SUCCESS_MSG("Vector<LiveCounter> construction and destruction passed") << std::endl;
+
+    // Test the move semantics of Vector<T>
+    std::cout << INFO_MSG("5. Testing Vector move semantics...") << std::endl;
+
+    {
+        // A move-only type can only be stored if growth moves the elements
+        Vector<std::unique_ptr<int>> v7;
+        for (int i = 0; i < N; i++) {
+            if (i % 2 == 0) {
+                v7.push_back(std::make_unique<int>(i));
+            } else {
+                v7.emplace_back(new int(i));
+            }
+        }
+        for (int i = 0; i < N; i++) {
+            ASSERT(*v7[i] == i, ERROR_MSG("Vectors are not equal"));
+        }
+
+        // Move constructor and move assignment steal the buffer
+        Vector<std::unique_ptr<int>> v8(std::move(v7));
+        ASSERT(v7.empty() && v8.size() == N, ERROR_MSG("Move constructor failed"));
+        v7 = std::move(v8);
+        ASSERT(v8.empty() && v7.size() == N && *v7[N - 1] == N - 1, ERROR_MSG("Move assignment failed"));
+    }
+
+    std::cout << SUCCESS_MSG("Vector<std::unique_ptr<int>> push_back(T&&), emplace_back() and moves passed") << std::endl;
+
+    {
+        Vector<TestClass> v9, v10;
+        std::vector<TestClass> std_v9;
+        for (int i = 0; i < 100; i++) {
+            TestClass tc;
+            tc = TestClass::Random(RandomGenerator::Engine());
+            v9.push_back(tc);
+            std_v9.push_back(tc);
+        }
+
+        // Copy assignment makes a deep copy
+        v10 = v9;
+        v9.clear();
+        ASSERT(v10.size() == 100, ERROR_MSG("Size mismatch"));
+        for (int i = 0; i < 100; i++) {
+            ASSERT(v10[i] == std_v9[i], ERROR_MSG("Vectors are not equal"));
+        }
+        v10 = v10;
+        ASSERT(v10.size() == 100 && v10[0] == std_v9[0], ERROR_MSG("Self assignment failed"));
+
+        // emplace_back() of an element of the vector itself, while the buffer is being inflated
+        Vector<TestClass> v11;
+        v11.push_back(std_v9[0]);
+        for (int i = 1; i < 100; i++) {
+            v11.emplace_back(v11[0]);
+        }
+        for (int i = 0; i < 100; i++) {
+            ASSERT(v11[i] == std_v9[0], ERROR_MSG("Vectors are not equal"));
+        }
+    }
+
+    std::cout << SUCCESS_MSG("Vector<TestClass> copy assignment and aliasing emplace_back() passed") << std::endl;
+
+    // Test the growth through the allocator extensions
+    std::cout << INFO_MSG("6. Testing Vector with ReallocAllocator...") << std::endl;
+
+    {
+        Vector<int, ReallocAllocator<int>> v12;
+        std::vector<int> std_v12;
+        for (int i = 0; i < N; i++) {
+            int random_int = RandomGenerator::RandomInt(0, 1000000);
+            v12.push_back(random_int);
+            std_v12.push_back(random_int);
+        }
+        // emplace_back() of its own first element while growing with realloc()
+        while (v12.size() != v12.capacity()) {
+            v12.push_back(0);
+            std_v12.push_back(0);
+        }
+        v12.emplace_back(v12[0]);
+        std_v12.push_back(std_v12[0]);
+
+        ASSERT(v12.size() == (int)std_v12.size(), ERROR_MSG("Size mismatch"));
+        for (int i = 0; i < v12.size(); i++) {
+            ASSERT(v12[i] == std_v12[i], ERROR_MSG("Vectors are not equal"));
+        }
+
+        // std::unique_ptr is trivially relocatable: it is grown by realloc() and never destroyed twice
+        Vector<std::unique_ptr<int>, ReallocAllocator<std::unique_ptr<int>>> v13;
+        for (int i = 0; i < N; i++) {
+            v13.emplace_back(new int(i));
+        }
+        for (int i = 0; i < N; i++) {
+            ASSERT(*v13[i] == i, ERROR_MSG("Vectors are not equal"));
+        }
+    }
+
+    std::cout << SUCCESS_MSG("Vector<int> and Vector<std::unique_ptr<int>> with ReallocAllocator passed") << std::endl;
+
+    // Test SmallVector<T, N>
+    std::cout << INFO_MSG("7. Testing SmallVector<TestClass, 4>...") << std::endl;
+
+    {
+        SmallVector<TestClass, 4> sv1;
+        std::vector<TestClass> std_sv1;
+        for (int i = 0; i < 4; i++) {
+            TestClass tc;
+            tc = TestClass::Random(RandomGenerator::Engine());
+            sv1.push_back(tc);
+            std_sv1.push_back(tc);
+        }
+        ASSERT(sv1.is_small() && sv1.capacity() == 4, ERROR_MSG("SmallVector should still be inline"));
+
+        // Copy and move while inline
+        SmallVector<TestClass, 4> sv2(sv1);
+        SmallVector<TestClass, 4> sv3(std::move(sv2));
+        ASSERT(sv2.empty() && sv2.is_small() && sv3.is_small(), ERROR_MSG("Inline move failed"));
+
+        // Overflow to the heap
+        for (int i = 4; i < N; i++) {
+            TestClass tc;
+            tc = TestClass::Random(RandomGenerator::Engine());
+            sv1.push_back(tc);
+            std_sv1.push_back(tc);
+        }
+        ASSERT(!sv1.is_small() && sv1.size() == N, ERROR_MSG("SmallVector should be on the heap"));
+        for (int i = 0; i < N; i++) {
+            ASSERT(sv1[i] == std_sv1[i], ERROR_MSG("Vectors are not equal"));
+        }
+        for (int i = 0; i < 4; i++) {
+            ASSERT(sv3[i] == std_sv1[i], ERROR_MSG("Vectors are not equal"));
+        }
+
+        // Moving a heap SmallVector steals the buffer and resets the source to its inline buffer
+        SmallVector<TestClass, 4> sv4(std::move(sv1));
+        ASSERT(sv1.empty() && sv1.is_small() && !sv4.is_small(), ERROR_MSG("Heap move failed"));
+        sv1.push_back(std_sv1[0]);
+        ASSERT(sv1.is_small() && sv1[0] == std_sv1[0], ERROR_MSG("Reuse after move failed"));
+
+        // Swap an inline and a heap SmallVector, then move an inline one into a plain Vector
+        sv3.swap(sv4);
+        ASSERT(sv3.size() == N && sv4.size() == 4, ERROR_MSG("Swap failed"));
+        for (int i = 0; i < N; i++) {
+            ASSERT(sv3[i] == std_sv1[i], ERROR_MSG("Vectors are not equal"));
+        }
+        Vector<TestClass> v14(std::move(sv4));
+        ASSERT(v14.size() == 4 && sv4.empty(), ERROR_MSG("Move into Vector failed"));
+        for (int i = 0; i < 4; i++) {
+            ASSERT(v14[i] == std_sv1[i], ERROR_MSG("Vectors are not equal"));
+        }
+
+        // Only that move can throw; moving a heap buffer cannot
+        ASSERT(!noexcept(Vector<TestClass>(std::move(sv4))) && noexcept(Vector<TestClass>(std::move(v14))),
+               ERROR_MSG("Wrong noexcept on moves"));
+        {
+            SmallVector<ThrowingCopy, 4> sv6;
+            for (int i = 0; i < 3; i++) {
+                sv6.emplace_back();
+            }
+            ThrowingCopy::copies_left = 1;
+            try {
+                Vector<ThrowingCopy> v15(std::move(sv6));
+                ASSERT(false, ERROR_MSG("Moving an inline SmallVector did not throw"));
+            } catch (const std::runtime_error&) {
+            }
+            ThrowingCopy::copies_left = INT_MAX;
+
+            // So does a copy while swapping two small vectors
+            SmallVector<ThrowingCopy, 4> sv7, sv8;
+            sv7.emplace_back();
+            sv7.emplace_back();
+            sv8.emplace_back();
+            ThrowingCopy::copies_left = 0;
+            try {
+                sv7.swap(sv8);
+                ASSERT(false, ERROR_MSG("Swapping inline SmallVectors did not throw"));
+            } catch (const std::runtime_error&) {
+            }
+            ThrowingCopy::copies_left = INT_MAX;
+        }
+
+        // The inline buffer is raw storage too
+        {
+            SmallVector<LiveCounter, 8> sv5;
+            LiveCounter lc;
+            sv5.push_back(lc);
+            ASSERT(LiveCounter::live == 2, ERROR_MSG("Spare capacity was constructed"));
+        }
+        ASSERT(LiveCounter::live == 0, ERROR_MSG("Destructor did not destroy the elements"));
+    }
+
+    std::cout << SUCCESS_MSG("SmallVector<TestClass, 4> inline storage, overflow, copy, move and swap passed") << std::endl;
+
+    // Test capacity management and growth policies
+    std::cout << INFO_MSG("8. Testing Vector capacity management...") << std::endl;
+
+    {
+        Vector<int> v15;
+        std::vector<int> std_v15;
+        v15.reserve(N);
+        ASSERT(v15.capacity() == N && v15.empty(), ERROR_MSG("reserve() failed"));
+        for (int i = 0; i < N; i++) {
+            v15.push_back(i);
+            std_v15.push_back(i);
+        }
+        ASSERT(v15.capacity() == N, ERROR_MSG("push_back() reallocated after reserve()"));
+
+        // clear() keeps the capacity
+        v15.clear();
+        ASSERT(v15.empty() && v15.capacity() == N, ERROR_MSG("clear() released the capacity"));
+
+        // resize() and pop_back()
+        v15.resize(N / 2, 7);
+        v15.resize(N);
+        ASSERT(v15.size() == N && v15[0] == 7 && v15[N / 2 - 1] == 7 && v15[N / 2] == 0 && v15[N - 1] == 0,
+               ERROR_MSG("resize() failed"));
+        v15.pop_back();
+        ASSERT(v15.size() == N - 1 && v15.back() == 0, ERROR_MSG("pop_back() failed"));
+        v15.resize(10);
+        ASSERT(v15.size() == 10 && v15.back() == 7, ERROR_MSG("resize() failed"));
+
+        // shrink_to_fit()
+        v15.shrink_to_fit();
+        ASSERT(v15.capacity() == 10 && v15[9] == 7, ERROR_MSG("shrink_to_fit() failed"));
+        v15.clear();
+        v15.shrink_to_fit();
+        ASSERT(v15.capacity() == 0, ERROR_MSG("shrink_to_fit() failed"));
+
+        // Every growth policy gives the same elements
+        Vector<int, std::allocator<int>, GrowOneAndHalf> v16;
+        Vector<int, ReallocAllocator<int>, GrowChunk<100>> v17;
+        for (int i = 0; i < N; i++) {
+            v16.push_back(std_v15[i]);
+            v17.push_back(std_v15[i]);
+        }
+        ASSERT(v17.capacity() == (N + 99) / 100 * 100, ERROR_MSG("GrowChunk capacity mismatch"));
+        for (int i = 0; i < N; i++) {
+            ASSERT(v16[i] == std_v15[i] && v17[i] == std_v15[i], ERROR_MSG("Vectors are not equal"));
+        }
+
+        // A SmallVector moves back into its inline buffer
+        SmallVector<TestClass, 4> sv6;
+        for (int i = 0; i < 10; i++) {
+            sv6.emplace_back(i);
+        }
+        while (sv6.size() > 3) {
+            sv6.pop_back();
+        }
+        sv6.shrink_to_fit();
+        ASSERT(sv6.is_small() && sv6.size() == 3 && sv6[2] == TestClass(2), ERROR_MSG("shrink_to_fit() failed"));
+    }
+
+    std::cout << SUCCESS_MSG("Vector reserve(), resize(), pop_back(), shrink_to_fit() and growth policies passed") << std::endl;
+
+    std::cout << INFO_MSG("9. Testing Vector iterators, insert(), erase() and assign()...") << std::endl;
+
+    {
+        Vector<int> v18;
+        std::vector<int> std_v18;
+        for (int i = 0; i < N; i++) {
+            int x = RandomGenerator::RandomInt(0, 1000000);
+            v18.push_back(x);
+            std_v18.push_back(x);
+        }
+
+        // STL algorithms work on the iterators
+        std::sort(v18.begin(), v18.end());
+        std::sort(std_v18.begin(), std_v18.end());
+        ASSERT(std::equal(v18.begin(), v18.end(), std_v18.begin(), std_v18.end()), ERROR_MSG("std::sort() failed"));
+        const Vector<int>& cv18 = v18;
+        ASSERT(std::accumulate(cv18.begin(), cv18.end(), 0LL) == std::accumulate(std_v18.begin(), std_v18.end(), 0LL),
+               ERROR_MSG("std::accumulate() failed"));
+        ASSERT(cv18.front() == std_v18.front() && cv18.back() == std_v18.back() && cv18[N / 2] == std_v18[N / 2],
+               ERROR_MSG("const access failed"));
+        ASSERT(cv18.data() == &v18[0] && cv18.cend() - cv18.cbegin() == N, ERROR_MSG("data() or cend() failed"));
+
+        // Range for over a vector of heavy elements
+        Vector<TestClass> v19;
+        for (int i = 0; i < 10; i++) {
+            v19.emplace_back(i, i * 0.5);
+        }
+        int expected = 0;
+        for (const TestClass& x : v19) {
+            ASSERT(x == TestClass(expected, expected * 0.5), ERROR_MSG("Range for failed"));
+            expected++;
+        }
+
+        // insert() and erase() match std::vector for both trivially relocatable and heavy elements
+        Vector<int> v20;
+        std::vector<int> std_v20;
+        Vector<std::string> v21;
+        std::vector<std::string> std_v21;
+        for (int i = 0; i < N / 10; i++) {
+            int pos = v20.size() == 0 ? 0 : RandomGenerator::RandomInt(0, 1000000) % (v20.size() + 1);
+            int x = RandomGenerator::RandomInt(0, 1000000);
+            switch (RandomGenerator::RandomInt(0, 1000000) % 5) {
+                case 0:
+                    v20.insert(v20.begin() + pos, x);
+                    std_v20.insert(std_v20.begin() + pos, x);
+                    v21.insert(v21.begin() + pos, std::to_string(x));
+                    std_v21.insert(std_v21.begin() + pos, std::to_string(x));
+                    break;
+                case 1:
+                    v20.insert(v20.begin() + pos, x % 7, x);
+                    std_v20.insert(std_v20.begin() + pos, x % 7, x);
+                    v21.insert(v21.begin() + pos, x % 7, std::to_string(x));
+                    std_v21.insert(std_v21.begin() + pos, x % 7, std::to_string(x));
+                    break;
+                case 2: {
+                    std::vector<int> src(x % 9, x);
+                    std::vector<std::string> str_src(x % 9, std::to_string(x));
+                    v20.insert(v20.begin() + pos, src.begin(), src.end());
+                    std_v20.insert(std_v20.begin() + pos, src.begin(), src.end());
+                    v21.insert(v21.begin() + pos, str_src.begin(), str_src.end());
+                    std_v21.insert(std_v21.begin() + pos, str_src.begin(), str_src.end());
+                    break;
+                }
+                case 3:
+                    if (pos < v20.size()) {
+                        v20.erase(v20.begin() + pos);
+                        std_v20.erase(std_v20.begin() + pos);
+                        v21.erase(v21.begin() + pos);
+                        std_v21.erase(std_v21.begin() + pos);
+                    }
+                    break;
+                case 4: {
+                    int last = std::min(pos + x % 5, v20.size());
+                    v20.erase(v20.begin() + pos, v20.begin() + last);
+                    std_v20.erase(std_v20.begin() + pos, std_v20.begin() + last);
+                    v21.erase(v21.begin() + pos, v21.begin() + last);
+                    std_v21.erase(std_v21.begin() + pos, std_v21.begin() + last);
+                    break;
+                }
+            }
+        }
+        ASSERT(std::equal(v20.begin(), v20.end(), std_v20.begin(), std_v20.end()), ERROR_MSG("insert() or erase() failed"));
+        ASSERT(std::equal(v21.begin(), v21.end(), std_v21.begin(), std_v21.end()), ERROR_MSG("insert() or erase() failed"));
+
+        // Inserting an element of the vector itself, and inserting from a single-pass input range
+        Vector<std::string> v22;
+        v22.assign({"a", "b", "c"});
+        v22.insert(v22.begin(), v22[2]);
+        v22.insert(v22.begin() + 1, 2, v22.back());
+        v22.emplace(v22.begin() + 3, 3, 'x');
+        std::istringstream in("d e");
+        v22.insert(v22.end() - 1, std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+        std::vector<std::string> std_v22 = {"c", "c", "c", "xxx", "a", "b", "d", "e", "c"};
+        ASSERT(std::equal(v22.begin(), v22.end(), std_v22.begin(), std_v22.end()), ERROR_MSG("insert() of an own element failed"));
+
+        // assign() reuses the buffer when it is large enough
+        int capacity = v22.capacity();
+        std::list<std::string> lst = {"x", "y"};
+        v22.assign(lst.begin(), lst.end());
+        ASSERT(v22.size() == 2 && v22[1] == "y" && v22.capacity() == capacity, ERROR_MSG("assign() failed"));
+        v22.assign(3, v22[0]);
+        ASSERT(v22.size() == 3 && v22[2] == "x", ERROR_MSG("assign() failed"));
+        v22.assign(100, "z");
+        ASSERT(v22.size() == 100 && v22.capacity() == 100 && v22[99] == "z", ERROR_MSG("assign() failed"));
+
+        // A SmallVector keeps inserting in place until the inline buffer is full
+        SmallVector<std::string, 4> sv7;
+        sv7.insert(sv7.end(), {"b", "d"});
+        sv7.insert(sv7.begin(), "a");
+        sv7.insert(sv7.begin() + 2, "c");
+        ASSERT(sv7.is_small() && sv7.size() == 4 && sv7[2] == "c" && sv7[3] == "d", ERROR_MSG("SmallVector insert() failed"));
+        sv7.insert(sv7.begin(), "0");
+        ASSERT(!sv7.is_small() && sv7.size() == 5 && sv7[0] == "0" && sv7[4] == "d", ERROR_MSG("SmallVector insert() failed"));
+    }
+
+    std::cout << SUCCESS_MSG("Vector iterators, insert(), erase() and assign() passed") << std::endl;
+
+    std::cout << INFO_MSG("10. Testing ChunkedVector<TestClass>...") << std::endl;
+
+    {
+        ChunkedVector<TestClass, 4> cv1;
+        std::vector<TestClass> std_cv1;
+        for (int i = 0; i < N / 10; i++) {
+            TestClass x;
+            x = TestClass::Random(RandomGenerator::Engine());
+            cv1.push_back(x);
+            std_cv1.push_back(x);
+        }
+        ASSERT(cv1.size() == N / 10 && cv1.capacity() % 16 == 0 && cv1.capacity() >= cv1.size(), ERROR_MSG("ChunkedVector size or capacity mismatch"));
+        for (int i = 0; i < N / 10; i++) {
+            ASSERT(cv1[i] == std_cv1[i] && cv1.at(i) == std_cv1[i], ERROR_MSG("ChunkedVector elements are not equal"));
+        }
+        ASSERT(std::equal(cv1.begin(), cv1.end(), std_cv1.begin(), std_cv1.end()), ERROR_MSG("ChunkedVector iterators failed"));
+        try {
+            cv1.at(N / 10);
+            ASSERT(false, ERROR_MSG("ChunkedVector::at() did not throw"));
+        } catch (const std::out_of_range&) {}
+
+        // Growth never moves an element: references and iterators stay valid
+        TestClass *first = &cv1.front();
+        ChunkedVector<TestClass, 4>::iterator it = cv1.begin() + 5;
+        for (int i = 0; i < 100; i++) {
+            cv1.emplace_back(cv1.front());
+        }
+        ASSERT(first == &cv1[0] && *it == std_cv1[5] && cv1.back() == std_cv1[0], ERROR_MSG("ChunkedVector moved an element"));
+
+        // Copy, move, swap
+        ChunkedVector<TestClass, 4> cv2(cv1);
+        ChunkedVector<TestClass, 4> cv3(std::move(cv1));
+        ASSERT(cv1.empty() && cv2.size() == cv3.size(), ERROR_MSG("ChunkedVector copy or move failed"));
+        cv1 = cv2;
+        cv2.swap(cv3);
+        for (int i = 0; i < cv1.size(); i++) {
+            ASSERT(cv1[i] == cv2[i] && cv2[i] == cv3[i], ERROR_MSG("ChunkedVector copy or move failed"));
+        }
+
+        // clear() keeps the chunks, shrink_to_fit() frees the unused ones
+        int capacity = cv2.capacity();
+        cv2.clear();
+        ASSERT(cv2.empty() && cv2.capacity() == capacity, ERROR_MSG("ChunkedVector::clear() released the chunks"));
+        cv2.push_back(TestClass(1));
+        cv2.shrink_to_fit();
+        ASSERT(cv2.capacity() == 16 && cv2.back() == TestClass(1), ERROR_MSG("ChunkedVector::shrink_to_fit() failed"));
+        cv2.pop_back();
+        cv2.shrink_to_fit();
+        ASSERT(cv2.capacity() == 0, ERROR_MSG("ChunkedVector::shrink_to_fit() failed"));
+    }
+
+    std::cout << SUCCESS_MSG("ChunkedVector<TestClass> push_back(), iterators, stable references and copies passed") << std::endl;
+
+    std::cout << INFO_MSG("11. Testing ConcurrentVector<std::string>...") << std::endl;
+
+    {
+        const int THREADS = 4;
+        ConcurrentVector<std::string> cv4;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < THREADS; t++) {
+            producers.emplace_back([&cv4, t, N]() {
+                for (int i = 0; i < N; i++) {
+                    cv4.push_back(std::to_string(t * N + i));
+                }
+            });
+        }
+
+        // A reader runs alongside the producers and may only see complete elements
+        bool reader_ok = true;
+        std::thread reader([&]() {
+            for (int round = 0; round < 100; round++) {
+                for (int i = 0; i < cv4.size(); i++) {
+                    if (cv4.is_published(i) && std::stoi(cv4[i]) >= THREADS * N) {
+                        reader_ok = false;
+                    }
+                }
+            }
+        });
+
+        for (std::thread& t : producers) {
+            t.join();
+        }
+        reader.join();
+        ASSERT(reader_ok, ERROR_MSG("ConcurrentVector reader saw a broken element"));
+        ASSERT(cv4.size() == THREADS * N, ERROR_MSG("ConcurrentVector size mismatch"));
+
+        // Every value was pushed exactly once, and each producer's values keep their order
+        std::vector<int> seen(THREADS * N, 0);
+        std::vector<int> last(THREADS, -1);
+        for (int i = 0; i < cv4.size(); i++) {
+            ASSERT(cv4.is_published(i), ERROR_MSG("ConcurrentVector element not published"));
+            int x = std::stoi(cv4.at(i));
+            seen[x]++;
+            ASSERT(x > last[x / N], ERROR_MSG("ConcurrentVector reordered a producer's elements"));
+            last[x / N] = x;
+        }
+        ASSERT(std::count(seen.begin(), seen.end(), 1) == THREADS * N, ERROR_MSG("ConcurrentVector lost or duplicated an element"));
+        try {
+            cv4.at(THREADS * N);
+            ASSERT(false, ERROR_MSG("ConcurrentVector::at() did not throw"));
+        } catch (const std::out_of_range&) {}
+    }
+
+    std::cout << SUCCESS_MSG("ConcurrentVector<std::string> concurrent push_back() and reads passed") << std::endl;
+
+    std::cout << INFO_MSG("12. Testing NumericVector<int> and NumericVector<double>...") << std::endl;
+
+    {
+        NumericVector<int> nv1, nv2;
+        NumericVector<double> nv3, nv4;
+        std::vector<int> std_nv1, std_nv2;
+        std::vector<double> std_nv3, std_nv4;
+        for (int i = 0; i < N + 3; i++) {
+            int x = RandomGenerator::RandomInt(-1000, 1000), y = RandomGenerator::RandomInt(-1000, 1000);
+            double dx = RandomGenerator::RandomDouble(-1.0, 1.0), dy = RandomGenerator::RandomDouble(-1.0, 1.0);
+            nv1.push_back(x);
+            nv2.push_back(y);
+            nv3.push_back(dx);
+            nv4.push_back(dy);
+            std_nv1.push_back(x);
+            std_nv2.push_back(y);
+            std_nv3.push_back(dx);
+            std_nv4.push_back(dy);
+        }
+        ASSERT(reinterpret_cast<std::uintptr_t>(nv1.data()) % 64 == 0 && reinterpret_cast<std::uintptr_t>(nv3.data()) % 64 == 0,
+               ERROR_MSG("NumericVector storage is not aligned"));
+        ASSERT(nv1.capacity() % NumericVector<int>::lanes == 0 && nv3.capacity() % NumericVector<double>::lanes == 0,
+               ERROR_MSG("NumericVector capacity is not padded"));
+
+        long long std_sum = 0, std_dot = 0;
+        double std_dsum = 0, std_ddot = 0;
+        for (int i = 0; i < N + 3; i++) {
+            std_sum += std_nv1[i];
+            std_dot += static_cast<long long>(std_nv1[i]) * std_nv2[i];
+            std_dsum += std_nv3[i];
+            std_ddot += std_nv3[i] * std_nv4[i];
+        }
+
+        // Every kernel set gives the same results as the plain loops
+        for (simd::isa target : {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2}) {
+            simd::set_isa(target);
+            ASSERT(nv1.sum() == std_sum && nv1.dot(nv2) == std_dot, ERROR_MSG("NumericVector<int> sum() or dot() failed"));
+            ASSERT(std::fabs(nv3.sum() - std_dsum) < 1e-9 && std::fabs(nv3.dot(nv4) - std_ddot) < 1e-9,
+                   ERROR_MSG("NumericVector<double> sum() or dot() failed"));
+            ASSERT(nv1.min() == *std::min_element(std_nv1.begin(), std_nv1.end()) && nv1.max() == *std::max_element(std_nv1.begin(), std_nv1.end()),
+                   ERROR_MSG("NumericVector<int> min() or max() failed"));
+            ASSERT(nv3.min() == *std::min_element(std_nv3.begin(), std_nv3.end()) && nv3.max() == *std::max_element(std_nv3.begin(), std_nv3.end()),
+                   ERROR_MSG("NumericVector<double> min() or max() failed"));
+
+            NumericVector<int> nv5(nv2);
+            NumericVector<double> nv6(nv4);
+            nv5.axpy(3, nv1);
+            nv6.axpy(0.5, nv3);
+            for (int i = 0; i < N + 3; i++) {
+                ASSERT(nv5[i] == std_nv2[i] + 3 * std_nv1[i] && std::fabs(nv6[i] - (std_nv4[i] + 0.5 * std_nv3[i])) < 1e-12,
+                       ERROR_MSG("NumericVector axpy() failed"));
+            }
+
+            ASSERT(nv5 != nv2 && nv5.compare(nv5) == 0 && nv1.compare(nv2) == (std_nv1 < std_nv2 ? -1 : 1),
+                   ERROR_MSG("NumericVector compare() failed"));
+            nv5 = nv2;
+            nv5[N] = nv2[N] + 1;
+            ASSERT(nv5.compare(nv2) == 1 && nv2.compare(nv5) == -1, ERROR_MSG("NumericVector compare() failed"));
+            nv5.pop_back();
+            ASSERT(nv5.compare(nv2) == 1 && nv6.compare(nv6) == 0, ERROR_MSG("NumericVector compare() failed"));
+
+            nv6.transform([](double x) { return x * 2.0; });
+            nv6.fill(1.5);
+            nv5.fill(-7);
+            ASSERT(nv6.sum() == 1.5 * (N + 3) && nv5.min() == -7 && nv5.max() == -7, ERROR_MSG("NumericVector fill() or transform() failed"));
+        }
+        simd::set_isa(simd::detect_isa());
+
+        try {
+            nv1.pop_back();
+            nv1.dot(nv2);
+            ASSERT(false, ERROR_MSG("NumericVector::dot() did not throw"));
+        } catch (const std::invalid_argument&) {}
+    }
+
+    std::cout << SUCCESS_MSG("NumericVector alignment, padding and bulk kernels passed") << std::endl;
+
+    std::cout << INFO_MSG("13. Testing SoAVector<int, double, std::string>...") << std::endl;
+
+    {
+        typedef std::tuple<int, double, std::string> Row;
+        SoAVector<int, double, std::string> soa1;
+        std::vector<Row> std_soa1;
+        for (int i = 0; i < N; i++) {
+            Row x(RandomGenerator::RandomInt(0, 1000000), RandomGenerator::RandomDouble(0.0, 1000000.0), std::to_string(i));
+            if (i % 2 == 0) {
+                soa1.push_back(x);
+            } else {
+                soa1.emplace_back(std::get<0>(x), std::get<1>(x), std::get<2>(x));
+            }
+            std_soa1.push_back(x);
+        }
+        ASSERT(soa1.size() == N && soa1.capacity() >= N, ERROR_MSG("SoAVector size mismatch"));
+
+        // Row proxies read and write whole records or single fields
+        for (int i = 0; i < N; i++) {
+            ASSERT(static_cast<Row>(soa1[i]) == std_soa1[i] && soa1.at(i).get<2>() == std::get<2>(std_soa1[i]),
+                   ERROR_MSG("SoAVector rows are not equal"));
+        }
+        soa1[0] = soa1[1];
+        soa1[2] = Row(-1, -1.0, "x");
+        soa1[3].get<1>() = 0.25;
+        ASSERT(static_cast<Row>(soa1[0]) == std_soa1[1] && static_cast<Row>(soa1[2]) == Row(-1, -1.0, "x") && soa1[3].get<1>() == 0.25,
+               ERROR_MSG("SoAVector row assignment failed"));
+        std_soa1[0] = std_soa1[1];
+        std_soa1[2] = Row(-1, -1.0, "x");
+        std::get<1>(std_soa1[3]) = 0.25;
+
+        // Columns are contiguous arrays
+        const SoAVector<int, double, std::string>& csoa1 = soa1;
+        Span<const double> doubles = csoa1.column<1>();
+        Span<int> ints = soa1.column<0>();
+        double dsum = 0.0;
+        long long isum = 0;
+        for (int i = 0; i < N; i++) {
+            dsum += std::get<1>(std_soa1[i]);
+            isum += std::get<0>(std_soa1[i]);
+        }
+        ASSERT(doubles.size() == N && doubles.data() + N == doubles.end() && ints[N - 1] == std::get<0>(std_soa1.back()),
+               ERROR_MSG("SoAVector::column() failed"));
+        ASSERT(std::accumulate(doubles.begin(), doubles.end(), 0.0) == dsum && simd::sum(ints.data(), ints.size()) == isum,
+               ERROR_MSG("SoAVector column scan failed"));
+
+        // pop_back(), clear(), swap()
+        soa1.pop_back();
+        ASSERT(soa1.size() == N - 1 && static_cast<Row>(soa1.back()) == std_soa1[N - 2], ERROR_MSG("SoAVector::pop_back() failed"));
+        SoAVector<int, double, std::string> soa2;
+        soa2.swap(soa1);
+        ASSERT(soa1.empty() && soa2.size() == N - 1, ERROR_MSG("SoAVector::swap() failed"));
+        int capacity = soa2.capacity();
+        soa2.clear();
+        ASSERT(soa2.empty() && soa2.capacity() == capacity && soa2.column<2>().empty(), ERROR_MSG("SoAVector::clear() failed"));
+
+        // A field that throws while the vector grows leaves every column as it was
+        SoAVector<int, ThrowingCopy> soa3;
+        ThrowingCopy tc;
+        while (soa3.size() < 4 || soa3.size() < soa3.capacity()) {
+            soa3.emplace_back(soa3.size(), tc);
+        }
+        int *ints_before = soa3.column<0>().data();
+        capacity = soa3.capacity();
+        ThrowingCopy::copies_left = 0;
+        try {
+            soa3.emplace_back(-1, tc);
+            ASSERT(false, ERROR_MSG("SoAVector::emplace_back() did not throw"));
+        } catch (const std::runtime_error&) {
+        }
+        ThrowingCopy::copies_left = INT_MAX;
+        ASSERT(soa3.size() == capacity && soa3.capacity() == capacity && soa3.column<0>().data() == ints_before,
+               ERROR_MSG("SoAVector::emplace_back() changed the columns when it threw"));
+
+        // The arguments may be fields of the vector itself, even when it grows
+        soa3.emplace_back(soa3[1].get<0>(), soa3[1].get<1>());
+        ASSERT(soa3.size() == capacity + 1 && soa3.back().get<0>() == 1, ERROR_MSG("SoAVector aliasing emplace_back() failed"));
+    }
+
+    std::cout << SUCCESS_MSG("SoAVector rows, columns, push_back() and pop_back() passed") << std::endl;
+
+    std::cout << INFO_MSG("14. Testing MappedVector<int> and MappedVector<Position>...") << std::endl;
+
+    {
+        struct Position {
+            int x, y, level;
+        };
+        const std::string path = "lab6_mapped_vector_test.bin";
+        const std::string position_path = "lab6_mapped_vector_test_pos.bin";
+        std::remove(path.c_str());
+        std::remove(position_path.c_str());
+
+        std::vector<int> std_mv1;
+        {
+            MappedVector<int> mv1(path);
+            ASSERT(mv1.empty(), ERROR_MSG("A new MappedVector is not empty"));
+            for (int i = 0; i < N; i++) {
+                int x = RandomGenerator::RandomInt(0, 1000000);
+                mv1.push_back(x);
+                std_mv1.push_back(x);
+            }
+            mv1.emplace_back(mv1[0]);
+            std_mv1.push_back(std_mv1[0]);
+            mv1.sync();
+        }
+
+        // Reopening maps the same elements back, with no parse step
+        {
+            MappedVector<int> mv2(path);
+            ASSERT(mv2.size() == N + 1 && std::equal(mv2.begin(), mv2.end(), std_mv1.begin(), std_mv1.end()),
+                   ERROR_MSG("MappedVector lost elements after reopening"));
+            mv2.resize(N / 2);
+            mv2.shrink_to_fit();
+            ASSERT(mv2.capacity() == N / 2 && mv2.back() == std_mv1[N / 2 - 1], ERROR_MSG("MappedVector::shrink_to_fit() failed"));
+            mv2.resize(N, 7);
+            ASSERT(mv2.size() == N && mv2[N - 1] == 7 && mv2.at(N / 2 - 1) == std_mv1[N / 2 - 1], ERROR_MSG("MappedVector::resize() failed"));
+            try {
+                mv2.at(N);
+                ASSERT(false, ERROR_MSG("MappedVector::at() did not throw"));
+            } catch (const std::out_of_range&) {}
+            try {
+                mv2.resize(-1);
+                ASSERT(false, ERROR_MSG("MappedVector::resize() accepted a negative size"));
+            } catch (const std::length_error&) {}
+            ASSERT(mv2.size() == N, ERROR_MSG("MappedVector::resize() changed the size on a negative size"));
+        }
+
+        // A file of another element type is rejected
+        try {
+            MappedVector<double> mv3(path);
+            ASSERT(false, ERROR_MSG("MappedVector opened a file of another element type"));
+        } catch (const std::runtime_error&) {}
+
+        // So is a header with a negative size or capacity (at bytes 16 and 24)
+        for (long offset : {16L, 24L}) {
+            std::FILE *f = std::fopen(path.c_str(), "r+b");
+            std::int64_t field = 0, corrupt = -1;
+            std::fseek(f, offset, SEEK_SET);
+            ASSERT(std::fread(&field, sizeof(field), 1, f) == 1, ERROR_MSG("Cannot read the MappedVector header"));
+            std::fseek(f, offset, SEEK_SET);
+            std::fwrite(&corrupt, sizeof(corrupt), 1, f);
+            std::fclose(f);
+            try {
+                MappedVector<int> mv3(path);
+                ASSERT(false, ERROR_MSG("MappedVector opened a file with a negative size or capacity"));
+            } catch (const std::runtime_error&) {}
+            f = std::fopen(path.c_str(), "r+b");
+            std::fseek(f, offset, SEEK_SET);
+            std::fwrite(&field, sizeof(field), 1, f);
+            std::fclose(f);
+        }
+        ASSERT(MappedVector<int>(path).size() == N, ERROR_MSG("MappedVector header was not restored"));
+
+        {
+            MappedVector<Position> mv4(position_path);
+            for (int i = 0; i < 100; i++) {
+                mv4.push_back(Position{i, -i, i % 3});
+            }
+            MappedVector<Position> mv5(std::move(mv4));
+            mv5.pop_back();
+        }
+        {
+            MappedVector<Position> mv6(position_path);
+            ASSERT(mv6.size() == 99 && mv6[98].x == 98 && mv6[98].y == -98 && mv6[98].level == 2, ERROR_MSG("MappedVector<Position> failed"));
+        }
+        std::remove(path.c_str());
+        std::remove(position_path.c_str());
+    }
+
+    std::cout << SUCCESS_MSG("MappedVector persistence, reopen, resize() and shrink_to_fit() passed") << std::endl;
+
+    std::cout << INFO_MSG("15. Testing CowVector<TestClass>...") << std::endl;
+
+    {
+        CowVector<TestClass> cow1;
+        std::vector<TestClass> std_cow1;
+        for (int i = 0; i < N / 10; i++) {
+            TestClass x;
+            x = TestClass::Random(RandomGenerator::Engine());
+            cow1.push_back(x);
+            std_cow1.push_back(x);
+        }
+        ASSERT(cow1.use_count() == 1, ERROR_MSG("CowVector use_count() mismatch"));
+
+        // Copies share the buffer until one of them writes
+        CowVector<TestClass> cow2(cow1);
+        CowVector<TestClass> cow3;
+        cow3 = cow2;
+        const CowVector<TestClass>& ccow1 = cow1;
+        const CowVector<TestClass>& ccow2 = cow2;
+        ASSERT(cow1.use_count() == 3 && ccow2.data() == ccow1.data(),
+               ERROR_MSG("CowVector copy did not share the buffer"));
+        for (int i = 0; i < N / 10; i++) {
+            ASSERT(ccow2[i] == std_cow1[i] && ccow2.at(i) == std_cow1[i], ERROR_MSG("CowVector elements are not equal"));
+        }
+        ASSERT(cow1.use_count() == 3, ERROR_MSG("CowVector read access detached"));
+
+        cow2.push_back(TestClass(1));
+        cow3[0] = TestClass(2);
+        ASSERT(cow1.use_count() == 1 && cow2.use_count() == 1 && cow3.use_count() == 1, ERROR_MSG("CowVector write did not detach"));
+        ASSERT(cow1.size() == N / 10 && cow2.size() == N / 10 + 1 && cow2.back() == TestClass(1) && cow3[0] == TestClass(2) &&
+               ccow1[0] == std_cow1[0], ERROR_MSG("CowVector write changed another copy"));
+
+        // A vector which handed out a mutable reference is deep-copied
+        TestClass& first = cow3[0];
+        CowVector<TestClass> cow4(cow3);
+        first = TestClass(3);
+        ASSERT(cow4.use_count() == 1 && cow4[0] == TestClass(2) && cow3[0] == TestClass(3), ERROR_MSG("CowVector leaked a reference into a copy"));
+
+        // Writing an element of the shared buffer into the vector itself
+        CowVector<TestClass> cow5(cow1);
+        ASSERT(cow5.use_count() == 2, ERROR_MSG("CowVector copy did not share the buffer"));
+        cow5.push_back(static_cast<const CowVector<TestClass>&>(cow5)[1]);
+        ASSERT(cow5.size() == N / 10 + 1 && cow5.back() == std_cow1[1] && cow1.size() == N / 10, ERROR_MSG("CowVector aliasing push_back() failed"));
+
+        // clear() of a shared vector copies nothing
+        CowVector<TestClass> cow6(cow1);
+        cow6.clear();
+        ASSERT(cow6.empty() && cow6.use_count() == 0 && cow1.use_count() == 1, ERROR_MSG("CowVector::clear() failed"));
+        cow6.resize(3, TestClass(4));
+        cow6.pop_back();
+        ASSERT(cow6.size() == 2 && cow6[1] == TestClass(4), ERROR_MSG("CowVector::resize() failed"));
+    }
+
+    std::cout << SUCCESS_MSG("CowVector<TestClass> sharing, detach on write and unshareable references passed") << std::endl;
+
     std::cout << SUCCESS_MSG("All tests passed!") << std::endl;
 
     return 0;
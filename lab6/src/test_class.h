@@ -0,0 +1,54 @@
+// The "heavy" element type shared by the tests and the benchmarks: an int, a double and a string.
+
+#pragma once
+#include <random>
+#include <string>
+#include <utility>
+
+// The class is used to test and benchmark Vector<TestClass>
+class TestClass {
+private:
+    int int_field;
+    double double_field;
+    std::string string_field;
+public:
+    TestClass(int int_field = 0, double double_field = 0.0, std::string string_field = "") : int_field(int_field), double_field(double_field), string_field(std::move(string_field)) {}
+    
+    TestClass(const TestClass& other) : int_field(other.int_field), double_field(other.double_field), string_field(other.string_field) {}
+
+    TestClass(TestClass&& other) noexcept : int_field(other.int_field), double_field(other.double_field), string_field(std::move(other.string_field)) {}
+
+    bool operator==(const TestClass& other) const {
+        return int_field == other.int_field && double_field == other.double_field && string_field == other.string_field;
+    }
+
+    TestClass& operator=(const TestClass& other) {
+        if (this != &other) {
+            int_field = other.int_field;
+            double_field = other.double_field;
+            string_field = other.string_field;
+        }
+        return *this;
+    }
+
+    TestClass& operator=(TestClass&& other) noexcept {
+        if (this != &other) {
+            int_field = other.int_field;
+            double_field = other.double_field;
+            string_field = std::move(other.string_field);
+        }
+        return *this;
+    }
+
+    // Build an object with an int and a double below 1000000 and a 128-char printable string,
+    // drawn from the given 32-bit generator
+    template<class Engine>
+    static TestClass Random(Engine& gen) {
+        std::uniform_int_distribution<int> char_dist(33, 122);
+        std::string str(128, ' ');
+        for (char& c : str) {
+            c = static_cast<char>(char_dist(gen));
+        }
+        return TestClass(static_cast<int>(gen() % 1000000), gen() / 4294.967296, str);
+    }
+};